@@ -2,16 +2,59 @@
 #include <stdio.h>
 #include "gurobi_c.h"
 #include "LPSolver.h"
-
+#include "solver.h"
+
+/* Files the solver writes when the game's solverLog is on */
+#define LP_LOG_FILE "sudoku.log"
+#define ILP_MODEL_FILE "sudokuILP.lp"
+#define LP_MODEL_FILE "sudokuLP.lp"
+
+/* A structure to represent the variables left in a board's model after presolving the set cells */
+/* Member: int length - the side of the board */
+/* Member: int count - number of model variables */
+/* Member: int *index - the model variable of every (cell,value) pair at (row*N+col)*N+value-1 , -1 if the pair was presolved away */
+/* Member: int *pair - the (cell,value) pair of every model variable , laid out like index */
+typedef struct lp_vars{
+    int length;
+    int count;
+    int *index;
+    int *pair;
+}lpVars;
+
+/* A structure to represent what the LP solver keeps in the game between commands */
+/* Member: GRBenv *env - the Gurobi environment (the license is checked once per session) */
+/* Member: GRBmodel *model - the live LP model , NULL until the first guess */
+/* Member: lpVars vars - the variables of the live model */
+/* Member: int rowsInBlock/colsInBlock - the block shape of the board the live model was built for */
+/* Member: int *base - the cell values the live model was built for , 0 for the cells that have variables */
+/* Member: int *applied - the cell values the variable bounds were last set for */
+typedef struct lp_session{
+    GRBenv *env;
+    GRBmodel *model;
+    lpVars vars;
+    int rowsInBlock;
+    int colsInBlock;
+    int *base;
+    int *applied;
+}lpSession;
 
 /*private functions declarations*/
-void allocateMemoryGRB(int DIM,double **lb,double **val, double **resBoard,char **vtype,int **ind,double **obj,char type);
-void freeMemoryGRB(int *ind,char *vtype,double *resBoard,double *val,double *lb,double *obj,char type);
-int addConstraints(GRBmodel *model,int *ind,double *val,int DIM,int SUBDIMROW,int SUBDIMCOL,char type);
-int getILPSolution(GRBenv *env, GRBmodel *model, double* resBoard, sudokuGame* sGame, int DIM);
-int getGuess(GRBenv *env, GRBmodel *model, double* resBoard, sudokuGame* sGame, int DIM,double x);
-int getGuessHint(GRBenv *env, GRBmodel *model, double* resBoard, sudokuGame* sGame, int DIM,double x);
-void randomizeCoefs(double *obj,int DIM);
+int presolveBoard(sudokuBoard *sBoard,lpVars *vars);
+void freeVars(lpVars *vars);
+int lpUnitCell(sudokuBoard *sBoard,int tableIndex,int unit,int k);
+int buildModel(GRBenv *env,GRBmodel **model,sudokuBoard *sBoard,lpVars *vars,char type,rngState *rng);
+void allocateMemoryGRB(int count,double **ub,char **vtype,double **obj,char type);
+void freeMemoryGRB(double *ub,char *vtype,double *obj,char type);
+int addConstraints(GRBmodel *model,sudokuBoard *sBoard,lpVars *vars);
+int getILPSolution(GRBenv *env, GRBmodel *model, double* resBoard, sudokuGame* sGame, lpVars *vars);
+int getScores(lpSession *session,double *resBoard,double *scores);
+int guessScores(sudokuGame *sGame,double *scores);
+void randomizeCoefs(double *obj,int count,int DIM,rngState *rng);
+int getLPEnv(sudokuGame *sGame,GRBenv **env);
+int getLiveModel(sudokuGame *sGame,lpSession **session);
+int rebuildLiveModel(sudokuGame *sGame,lpSession *session);
+void freeLiveModel(lpSession *session);
+int writeModel(sudokuGame *sGame,GRBmodel *model,const char *fileName);
 
 
 /**  ILPSolver:
@@ -20,52 +63,37 @@ void randomizeCoefs(double *obj,int DIM);
 * @return int - 1 if the board was solved and currSol member of the game was updated, 0 o/w
 */
 int ILPSolver(sudokuGame *sGame){
-    int SUBDIMROW,SUBDIMCOL,DIM;
     GRBenv *env = NULL;
     GRBmodel *model = NULL;
-    double *lb=NULL,*val=NULL,*resBoard=NULL,*obj=NULL,objval;
-    char *vtype=NULL;
-    int i,j,v,error=0,optimstatus, *ind = NULL;
-    SUBDIMROW = sGame->currBoard->rowsInBlock , SUBDIMCOL = sGame->currBoard->colsInBlock;
-    DIM = sGame->currBoard->length;
+    lpVars vars;
+    double *resBoard=NULL,objval;
+    int error=0,optimstatus;
 
-    /*allocate memory for all auxiliary arrays*/
-    allocateMemoryGRB(DIM,&lb,&val,&resBoard,&vtype,&ind,&obj,'I');
-
-    /* Create an empty model */
-    for (i = 0; i < DIM; i++) {
-        for (j = 0; j < DIM; j++) {
-            for (v = 0; v < DIM; v++) {
-                if (sGame->currBoard->board[i][j].value == v+1)
-                    lb[i*DIM*DIM+j*DIM+v] = 1;
-                else
-                    lb[i*DIM*DIM+j*DIM+v] = 0;
-                vtype[i*DIM*DIM+j*DIM+v] = GRB_BINARY;
-            }
-        }
+    /* Keep only the (cell,value) pairs the set cells still allow */
+    if(!presolveBoard(sGame->currBoard,&vars)){
+        freeVars(&vars);
+        return 0;
+    }
+    resBoard = (double *) malloc((vars.count+1)*sizeof(double));
+    if(resBoard==NULL){
+        printf("Error: memory allocation failed\n");
+        exit(0);
     }
-    /* Create environment */
-    error = GRBloadenv(&env, "sudokuILP.log");
-    if (error) goto QUIT;
-    error = GRBsetintparam(env, GRB_INT_PAR_LOGTOCONSOLE, 0);
-    if (error) goto QUIT;
 
-    /* Create new model */
-    error = GRBnewmodel(env, &model, "sudoku", DIM*DIM*DIM, NULL, lb, NULL,vtype, NULL);
+    /* Get the session's environment */
+    error = getLPEnv(sGame, &env);
     if (error) goto QUIT;
 
-
-
-    /*Add sudokuBoard constraints*/
-    error = addConstraints(model,ind,val,DIM,SUBDIMROW,SUBDIMCOL,'I');
+    /* Create new model with the board's constraints */
+    error = buildModel(env,&model,sGame->currBoard,&vars,'I',NULL);
     if (error) goto QUIT;
 
     /* Optimize model */
     error = GRBoptimize(model);
     if (error) goto QUIT;
 
-    /* Write model to 'sudoku.lp' */
-    error = GRBwrite(model, "sudokuILP.lp");
+    /* Write model to 'sudokuILP.lp' if asked to */
+    error = writeModel(sGame, model, ILP_MODEL_FILE);
     if (error) goto QUIT;
 
     /* Capture solution information */
@@ -74,149 +102,406 @@ int ILPSolver(sudokuGame *sGame){
     error = GRBgetdblattr(model, GRB_DBL_ATTR_OBJVAL, &objval);
     if (error) goto QUIT;
 
-    error = getILPSolution(env,model,resBoard,sGame,DIM);
+    error = getILPSolution(env,model,resBoard,sGame,&vars);
     if (error) goto QUIT;
     QUIT: /* Error reporting */
-    if (error){
-        freeMemoryGRB(ind,vtype,resBoard,val,lb,obj,'I');
-        GRBfreemodel(model);
-        GRBfreeenv(env);
-        return 0;
-    }
-
-    freeMemoryGRB(ind,vtype,resBoard,val,lb,obj,'I');
+    free(resBoard);
+    freeVars(&vars);
     GRBfreemodel(model);
-    GRBfreeenv(env);
+    if (error)
+        return 0;
     return 1; /*Success*/
 }
-/**  addConstraints:
-* @brief Adds all LP constraints for the sudoku board to the Gurobi model
-* @param GRBmodel *model - a pointer to the Gurobi model used to solve the board
-* @param int *ind - array to define which variables will participate in a constraint
-* @param double *val - array to define the coefficients for each variable participating in a constraint
-* @param int DIM/SUBDIMROW/SUBDIMCOL - indicates the size of the board being solved
-* @param char type - differs between adding constraints of an ILP solver or a LP solver
+
+/**  LPSolverRelease:
+* @brief Frees what the LP solver keeps in the game - the live model and the Gurobi environment
+* @param sudokuGame *sGame - a pointer to the sudoku game being played
+* @return void
+*/
+void LPSolverRelease(sudokuGame *sGame){
+    lpSession *session = (lpSession *)sGame->solverState;
+    if(session==NULL)
+        return;
+    freeLiveModel(session);
+    GRBfreeenv(session->env);
+    free(session);
+    sGame->solverState = NULL;
+}
+
+/**  getLPEnv:
+* @brief Gets the game's Gurobi environment , creating it on first use (the license is checked once per session)
+* @param sudokuGame *sGame - a pointer to the sudoku game being played
+* @param GRBenv **env - gets the environment , logging to LP_LOG_FILE only if the game's solverLog is on
 * @return int - returns 0 on success or 1 o/w
 */
-int addConstraints(GRBmodel *model,int *ind,double *val,int DIM,int SUBDIMROW,int SUBDIMCOL,char type){
-    int i,j,v,ig,jg,count,error=0;
-    /* Each cell gets a value */
-    for (i = 0; i < DIM; i++) {
-        for (j = 0; j < DIM; j++) {
-            for (v = 0; v < DIM; v++) {
-                ind[v] = i*DIM*DIM + j*DIM + v;
-                val[v] = 1.0;
-            }
-            error = GRBaddconstr(model, DIM, ind, val, GRB_EQUAL, 1.0, NULL);
-            if (error) return 1;
+int getLPEnv(sudokuGame *sGame,GRBenv **env){
+    GRBenv *newEnv = NULL;
+    lpSession *session;
+    if(sGame->solverState==NULL){
+        if(GRBloadenv(&newEnv, NULL) || GRBsetintparam(newEnv, GRB_INT_PAR_LOGTOCONSOLE, 0)){
+            GRBfreeenv(newEnv);
+            return 1;
         }
-    }
-    if(type=='L'){
-        /*Non-negativity for continuous variables for LP version*/
-        for (i = 0; i < DIM; i++) {
-            for (j = 0; j < DIM; j++) {
-                for (v = 0; v < DIM; v++) {
-                    ind[0] = i*DIM*DIM + j*DIM + v;
-                    val[0] = 1.0;
-                    error = GRBaddconstr(model, 1, ind, val, GRB_GREATER_EQUAL, 0.0, NULL);
-                    if (error) return 1;
-                }
-            }
+        session = (lpSession *) calloc(1,sizeof(lpSession));
+        if(session==NULL){
+            printf("Error: memory allocation has failed in getLPEnv, Exiting...\n");
+            exit(0);
         }
-        /*Upper-bounding for continous variables for LP version*/
-        for (i = 0; i < DIM; i++) {
-            for (j = 0; j < DIM; j++) {
-                for (v = 0; v < DIM; v++) {
-                    ind[0] = i*DIM*DIM + j*DIM + v;
-                    val[0] = 1.0;
-                    error = GRBaddconstr(model, 1, ind, val, GRB_LESS_EQUAL, 1.0, NULL);
-                    if (error) return 1;
-                }
-            }
+        session->env = newEnv;
+        sGame->solverState = session;
+    }
+    *env = ((lpSession *)sGame->solverState)->env;
+    return GRBsetstrparam(*env, GRB_STR_PAR_LOGFILE, sGame->solverLog ? LP_LOG_FILE : "") ? 1 : 0;
+}
+
+/**  getLiveModel:
+* @brief Brings the live LP model up to date with the board - only the bounds of cells changed since the last call
+*        are updated, so the model keeps its basis and re-optimizes from it. The model is rebuilt when a cell
+*        that was presolved out of it changed (or on a board of another size)
+* @param sudokuGame *sGame - a pointer to the sudoku game being played
+* @param lpSession **session - gets the session holding the live model , with a new random objective
+* @return int - returns 0 on success or 1 o/w
+*/
+int getLiveModel(sudokuGame *sGame,lpSession **session){
+    GRBenv *env = NULL;
+    lpSession *lp;
+    sudokuBoard *sBoard = sGame->currBoard;
+    double *lb=NULL,*ub=NULL,*obj=NULL;
+    int *ind=NULL,cell,v,var,value,changes=0,rebuild=0,error=0,N=sBoard->length;
+
+    error = getLPEnv(sGame, &env);
+    if (error) return 1;
+    lp = (lpSession *)sGame->solverState;
+    *session = lp;
+    if(lp->model==NULL || lp->rowsInBlock!=sBoard->rowsInBlock || lp->colsInBlock!=sBoard->colsInBlock)
+        rebuild = 1;
+    for (cell = 0; !rebuild && cell < N*N; cell++) {
+        value = CELL(sBoard,cell/N,cell%N).value;
+        if(lp->base[cell]!=0 && value!=lp->base[cell])/*A set cell that has no variables changed*/
+            rebuild = 1;
+        else if(lp->base[cell]==0 && value!=0 && lp->vars.index[cell*N+value-1]==-1)/*A value the model has no variable for*/
+            rebuild = 1;
+    }
+    if(rebuild)
+        return rebuildLiveModel(sGame,lp);
+
+    ind = (int *) malloc((lp->vars.count+1)*sizeof(int));
+    lb = (double *) malloc((lp->vars.count+1)*sizeof(double));
+    ub = (double *) malloc((lp->vars.count+1)*sizeof(double));
+    obj = (double *) malloc((lp->vars.count+1)*sizeof(double));
+    if(ind==NULL || lb==NULL || ub==NULL || obj==NULL){
+        printf("Error: memory allocation has failed in getLiveModel, Exiting...\n");
+        exit(0);
+    }
+    /*Pin the variables of cells set since the last call , release those of cells cleared since*/
+    for (cell = 0; cell < N*N; cell++) {
+        value = CELL(sBoard,cell/N,cell%N).value;
+        if(lp->base[cell]!=0 || value==lp->applied[cell])
+            continue;
+        for (v = 0; v < N; v++) {
+            var = lp->vars.index[cell*N+v];
+            if(var==-1)
+                continue;
+            ind[changes] = var;
+            lb[changes] = (value==v+1) ? 1.0 : 0.0;
+            ub[changes] = (value==0) ? 1.0 : lb[changes];
+            changes++;
         }
+        lp->applied[cell] = value;
     }
-    /* Each value must appear once in each row */
-    for (v = 0; v < DIM; v++) {
-        for (j = 0; j < DIM; j++) {
-            for (i = 0; i < DIM; i++) {
-                ind[i] = i*DIM*DIM + j*DIM + v;
-                val[i] = 1.0;
+    if(changes>0){
+        error = GRBsetdblattrlist(lp->model, GRB_DBL_ATTR_LB, changes, ind, lb);
+        if (error) goto QUIT;
+        error = GRBsetdblattrlist(lp->model, GRB_DBL_ATTR_UB, changes, ind, ub);
+        if (error) goto QUIT;
+    }
+    /*Randomize coefficients for the objective value)*/
+    randomizeCoefs(obj,lp->vars.count,N,&sGame->rng);
+    if(lp->vars.count>0){
+        error = GRBsetdblattrarray(lp->model, GRB_DBL_ATTR_OBJ, 0, lp->vars.count, obj);
+        if (error) goto QUIT;
+    }
+    error = GRBsetstrparam(GRBgetenv(lp->model), GRB_STR_PAR_LOGFILE, sGame->solverLog ? LP_LOG_FILE : "");
+
+    QUIT:
+    free(ind);
+    free(lb);
+    free(ub);
+    free(obj);
+    if (error){/*The model may be out of sync with the board - build it again next time*/
+        freeLiveModel(lp);
+        return 1;
+    }
+    return 0;
+}
+
+/**  rebuildLiveModel:
+* @brief Builds the live LP model again from the presolved board
+* @param sudokuGame *sGame - a pointer to the sudoku game being played
+* @param lpSession *session - the session holding the live model
+* @return int - returns 0 on success or 1 o/w
+*/
+int rebuildLiveModel(sudokuGame *sGame,lpSession *session){
+    sudokuBoard *sBoard = sGame->currBoard;
+    int cell,N=sBoard->length;
+    freeLiveModel(session);
+    if(!presolveBoard(sBoard,&session->vars) || buildModel(session->env,&session->model,sBoard,&session->vars,'L',&sGame->rng)){
+        freeLiveModel(session);
+        return 1;
+    }
+    session->rowsInBlock = sBoard->rowsInBlock;
+    session->colsInBlock = sBoard->colsInBlock;
+    session->base = (int *) malloc(N*N*sizeof(int));
+    session->applied = (int *) malloc(N*N*sizeof(int));
+    if(session->base==NULL || session->applied==NULL){
+        printf("Error: memory allocation has failed in rebuildLiveModel, Exiting...\n");
+        exit(0);
+    }
+    for (cell = 0; cell < N*N; cell++) {
+        session->base[cell] = session->applied[cell] = CELL(sBoard,cell/N,cell%N).value;
+    }
+    return 0;
+}
+
+/**  freeLiveModel:
+* @brief Frees the live LP model and its variables
+* @param lpSession *session - the session holding the live model
+* @return void
+*/
+void freeLiveModel(lpSession *session){
+    GRBfreemodel(session->model);
+    session->model = NULL;
+    freeVars(&session->vars);
+    session->vars.index = NULL;
+    session->vars.pair = NULL;
+    session->vars.count = 0;
+    free(session->base);
+    free(session->applied);
+    session->base = NULL;
+    session->applied = NULL;
+}
+
+/**  writeModel:
+* @brief Writes a model to a file for diagnostics , only if the game's solverLog is on
+* @param sudokuGame *sGame - a pointer to the sudoku game being played
+* @param GRBmodel *model - a pointer to the model
+* @param const char *fileName - the file to write to
+* @return int - returns 0 on success or 1 o/w
+*/
+int writeModel(sudokuGame *sGame,GRBmodel *model,const char *fileName){
+    if(!sGame->solverLog)
+        return 0;
+    return GRBwrite(model, fileName) ? 1 : 0;
+}
+
+/**  presolveBoard:
+* @brief Finds the (cell,value) pairs that still need a model variable - values that are legal in empty cells
+* @param sudokuBoard *sBoard - a pointer to the sudoku board being solved
+* @param lpVars *vars - gets the model variables (must be freed with freeVars)
+* @return int - 0 if the set cells already make the board unsolvable , 1 o/w
+*/
+int presolveBoard(sudokuBoard *sBoard,lpVars *vars){
+    int i,j,v,cell,block,candidates,feasible,N=sBoard->length;
+    vars->length = N;
+    vars->count = 0;
+    vars->index = (int *) malloc(N*N*N*sizeof(int));
+    vars->pair = (int *) malloc(N*N*N*sizeof(int));
+    if(vars->index==NULL || vars->pair==NULL){
+        printf("Error: memory allocation has failed in presolveBoard, Exiting...\n");
+        exit(0);
+    }
+    feasible = !isBoardError(sBoard);
+    for (i = 0; i < N; i++) {
+        for (j = 0; j < N; j++) {
+            cell = i*N+j;
+            block = (sBoard->rowsInBlock)*(i/sBoard->rowsInBlock)+(j/sBoard->colsInBlock);
+            candidates = 0;
+            for (v = 0; v < N; v++) {
+                vars->index[cell*N+v] = -1;
+                if(CELL(sBoard,i,j).value!=0)
+                    continue;
+                if(UNIT_HAS(sBoard,invalidRows,i,v) || UNIT_HAS(sBoard,invalidCols,j,v) || UNIT_HAS(sBoard,invalidBlocks,block,v))
+                    continue;
+                vars->index[cell*N+v] = vars->count;
+                vars->pair[vars->count++] = cell*N+v;
+                candidates++;
             }
-            error = GRBaddconstr(model, DIM, ind, val, GRB_EQUAL, 1.0, NULL);
-            if (error) return 1;
+            if(CELL(sBoard,i,j).value==0 && candidates==0)/*No value can be placed in this cell*/
+                feasible = 0;
         }
     }
+    return feasible;
+}
 
-    /* Each value must appear once in each column */
-    for (v = 0; v < DIM; v++) {
-        for (i = 0; i < DIM; i++) {
-            for (j = 0; j < DIM; j++) {
-                ind[j] = i*DIM*DIM + j*DIM + v;
-                val[j] = 1.0;
-            }
-            error = GRBaddconstr(model, DIM, ind, val, GRB_EQUAL, 1.0, NULL);
-            if (error) return 1;
+/**  freeVars:
+* @brief Frees the memory used by the model variables
+* @param lpVars *vars - a pointer to the model variables
+* @return void
+*/
+void freeVars(lpVars *vars){
+    free(vars->index);
+    free(vars->pair);
+}
+
+/**  lpUnitCell:
+* @brief Finds the k-th cell of a row , column or block
+* @param sudokuBoard *sBoard - a pointer to the sudoku board being solved
+* @param int tableIndex - 0 for a row , 1 for a column and 2 for a block
+* @param int unit - index of the row/column/block
+* @param int k - index of the cell inside the unit
+* @return int - the cell (row*N+col)
+*/
+int lpUnitCell(sudokuBoard *sBoard,int tableIndex,int unit,int k){
+    int ROWS=sBoard->rowsInBlock,COLS=sBoard->colsInBlock,N=sBoard->length;
+    if(tableIndex==0)
+        return unit*N+k;
+    if(tableIndex==1)
+        return k*N+unit;
+    return (ROWS*(unit/ROWS)+k/COLS)*N + COLS*(unit%ROWS)+k%COLS;
+}
+
+/**  buildModel:
+* @brief Creates a Gurobi model of the presolved board - a variable for every pair left and the constraints not yet satisfied
+* @param GRBenv *env - a pointer to the Gurobi environment
+* @param GRBmodel **model - gets the new model (must be freed by the caller)
+* @param sudokuBoard *sBoard - a pointer to the sudoku board being solved
+* @param lpVars *vars - the model variables
+* @param char type - 'I' for a binary ILP model , 'L' for a continuous LP model with a random objective
+* @param rngState *rng - the generator the random objective is drawn from (unused for 'I')
+* @return int - returns 0 on success or 1 o/w
+*/
+int buildModel(GRBenv *env,GRBmodel **model,sudokuBoard *sBoard,lpVars *vars,char type,rngState *rng){
+    double *ub=NULL,*obj=NULL;
+    char *vtype=NULL;
+    int k,error=0;
+
+    /*allocate memory for all auxiliary arrays*/
+    allocateMemoryGRB(vars->count,&ub,&vtype,&obj,type);
+    for (k = 0; k < vars->count; k++) {
+        ub[k] = 1.0;/*Bounds the continuous variables of the LP version (lower bound is 0 by default)*/
+        vtype[k] = (type=='I') ? GRB_BINARY : GRB_CONTINUOUS;
+    }
+    if(type=='L'){
+        /*Randomize coefficients for the objective value)*/
+        randomizeCoefs(obj,vars->count,sBoard->length,rng);
+    }
+
+    /* Create new model */
+    error = GRBnewmodel(env, model, "sudoku", vars->count, obj, NULL, ub,vtype, NULL);
+    if (error) goto QUIT;
+
+    if(type=='L'){
+        /* Change objective sense to maximization */
+        error = GRBsetintattr(*model, GRB_INT_ATTR_MODELSENSE, GRB_MAXIMIZE);
+        if (error) goto QUIT;
+    }
+
+    /* update the model - to integrate new variables */
+    error = GRBupdatemodel(*model);
+    if (error) goto QUIT;
+
+    /*Add sudokuBoard constraints*/
+    error = addConstraints(*model,sBoard,vars);
+    if (error) goto QUIT;
+
+    QUIT:
+    freeMemoryGRB(ub,vtype,obj,type);
+    return error ? 1 : 0;
+}
+
+/**  addConstraints:
+* @brief Adds the constraints that the set cells don't satisfy yet to the Gurobi model , all in one call
+* @param GRBmodel *model - a pointer to the Gurobi model used to solve the board
+* @param sudokuBoard *sBoard - a pointer to the sudoku board being solved
+* @param lpVars *vars - the model variables
+* @return int - returns 0 on success or 1 o/w
+*/
+int addConstraints(GRBmodel *model,sudokuBoard *sBoard,lpVars *vars){
+    int k,v,t,unit,cell,rows=0,nz=0,error=0,N=sBoard->length;
+    int *cbeg,*cind;
+    double *cval,*rhs;
+    char *sense;
+    /*The constraint matrix in compressed rows - every variable is in exactly 4 open constraints*/
+    cbeg = (int *) malloc((4*N*N+1)*sizeof(int));
+    cind = (int *) malloc((4*vars->count+1)*sizeof(int));
+    cval = (double *) malloc((4*vars->count+1)*sizeof(double));
+    rhs = (double *) malloc((4*N*N+1)*sizeof(double));
+    sense = (char *) malloc((4*N*N+1)*sizeof(char));
+    if(cbeg==NULL || cind==NULL || cval==NULL || rhs==NULL || sense==NULL){
+        printf("Error: memory allocation has failed in addConstraints, Exiting...\n");
+        exit(0);
+    }
+    /* Each empty cell gets a value */
+    for (cell = 0; cell < N*N; cell++) {
+        if(CELL(sBoard,cell/N,cell%N).value!=0)
+            continue;
+        cbeg[rows++] = nz;
+        for (v = 0; v < N; v++) {
+            if(vars->index[cell*N+v]==-1)
+                continue;
+            cind[nz] = vars->index[cell*N+v];
+            cval[nz++] = 1.0;
         }
     }
-    /* Each value must appear once in each subgrid */
-    for (v = 0; v < DIM; v++) {
-        for (ig = 0; ig < SUBDIMCOL; ig++) { /*Check if order of SUBDIMCOL and SUBDIMROW is OK*/
-            for (jg = 0; jg < SUBDIMROW; jg++) {
-            count = 0;
-            for (i = ig*SUBDIMROW; i < (ig+1)*SUBDIMROW; i++) {
-                for (j = jg*SUBDIMCOL; j < (jg+1)*SUBDIMCOL; j++) {
-                    ind[count] = i*DIM*DIM + j*DIM + v;
-                    val[count] = 1.0;
-                    count++;
+    /* Each value missing from a row , column or subgrid must appear once in it */
+    for (t = 0; t < 3; t++) {
+        for (unit = 0; unit < N; unit++) {
+            for (v = 0; v < N; v++) {
+                if(sBoard->occurrences[UNIT_SLOT(sBoard,t,unit,v)]>0)/*Already satisfied by a set cell*/
+                    continue;
+                cbeg[rows] = nz;
+                for (k = 0; k < N; k++) {
+                    cell = lpUnitCell(sBoard,t,unit,k);
+                    if(vars->index[cell*N+v]==-1)
+                        continue;
+                    cind[nz] = vars->index[cell*N+v];
+                    cval[nz++] = 1.0;
                 }
-            }
-            error = GRBaddconstr(model, DIM, ind, val, GRB_EQUAL, 1.0, NULL);
-            if (error) return 1;
+                if(nz==cbeg[rows]){/*The value can't be placed anywhere in the unit*/
+                    error = 1;
+                    goto QUIT;
+                }
+                rows++;
             }
         }
     }
-    return 0;/*Success*/
+    for (k = 0; k < rows; k++) {
+        sense[k] = GRB_EQUAL;
+        rhs[k] = 1.0;
+    }
+    error = GRBaddconstrs(model, rows, nz, cbeg, cind, cval, sense, rhs, NULL);
+
+    QUIT:
+    free(cbeg);
+    free(cind);
+    free(cval);
+    free(rhs);
+    free(sense);
+    return error ? 1 : 0;
 }
+
 /**  allocateMemoryGRB:
-* @brief allocates memory to all relevant arrays for the ILP/LP solvers
-* @param int DIM - indicates the size of the board being solved
-* @param double **lb- a pointer to an array that represents variables lower-bounds
-* @param double **val - a pointer to an array that defines the coefficients for each variable participating in a constraint
-* @param double **resBoard - a pointer to an array that will get the result of the Gurobi model
+* @brief allocates memory to the per-variable arrays of an ILP/LP model
+* @param int count - number of model variables
+* @param double **ub - a pointer to an array that represents variables upper-bounds
 * @param char **vtype - a pointer to an array that defines the variable types (e.g. BINARY,CONTINOUOS)
-* @param int **ind - a pointer to an array that defines which variables will participate in a constraint
 * @param double **obj - a pointer to an array that represents the objective function for LP solver
 * @param char type - differs between memory allocation of an ILP solver or a LP solver
 * @return void
 */
-void allocateMemoryGRB(int DIM,double **lb,double **val, double **resBoard,char **vtype,int **ind,double **obj,char type){
-    *lb = (double *) malloc(DIM*DIM*DIM*sizeof(double));
-    if(*lb==NULL){
+void allocateMemoryGRB(int count,double **ub,char **vtype,double **obj,char type){
+    *ub = (double *) malloc((count+1)*sizeof(double));
+    if(*ub==NULL){
         printf("Error: memory allocation failed\n");
         exit(0);
     }
-    *val = (double *) malloc(DIM*sizeof(double));
-    if(*val==NULL){
-        printf("Error: memory allocation failed\n");
-        exit(0);
-    }
-    *resBoard = (double *) malloc(DIM*DIM*DIM*sizeof(double));
-    if(*resBoard==NULL){
-        printf("Error: memory allocation failed\n");
-        exit(0);
-    }
-    *vtype = (char *) malloc(DIM*DIM*DIM*sizeof(char));
+    *vtype = (char *) malloc((count+1)*sizeof(char));
     if(*vtype==NULL){
         printf("Error: memory allocation failed\n");
         exit(0);
     }
-    *ind = (int *) malloc(DIM*sizeof(int));
-    if(*ind==NULL){
-        printf("Error: memory allocation failed\n");
-        exit(0);
-    }
     if (type=='L'){
-        *obj = (double *) malloc(DIM*DIM*DIM*sizeof(double));
+        *obj = (double *) malloc((count+1)*sizeof(double));
         if(*obj==NULL){
             printf("Error: memory allocation failed\n");
             exit(0);
@@ -226,22 +511,16 @@ void allocateMemoryGRB(int DIM,double **lb,double **val, double **resBoard,char
 }
 
 /**  freeMemoryGRB:
-* @brief frees memory to all relevant arrays for the ILP/LP solvers
-* @param double *lb- array that represents variables lower-bounds
-* @param double *val - array that defines the coefficients for each variable participating in a constraint
-* @param double *resBoard - array that will get the result of the Gurobi model
+* @brief frees the per-variable arrays of an ILP/LP model
+* @param double *ub - array that represents variables upper-bounds
 * @param char *vtype - array that defines the variable types (e.g. BINARY,CONTINOUOS)
-* @param int *ind - array that defines which variables will participate in a constraint
 * @param double *obj - array that represents the objective function for LP solver
 * @param char type - differs between memory allocation of an ILP solver or a LP solver
 * @return void
 */
-void freeMemoryGRB(int *ind,char *vtype,double *resBoard,double *val,double *lb,double *obj,char type){
-    free(ind);
+void freeMemoryGRB(double *ub,char *vtype,double *obj,char type){
+    free(ub);
     free(vtype);
-    free(resBoard);
-    free(val);
-    free(lb);
     if(type=='L'){
         free(obj);
     }
@@ -253,25 +532,27 @@ void freeMemoryGRB(int *ind,char *vtype,double *resBoard,double *val,double *lb,
 * @param GRBenv *env - a pointer to the Gurobi environment used to solve the board
 * @param GRBmodel *resBoard - array that will get the result of the Gurobi model
 * @param sudokuGame *sGame - a pointer to the sudoku game being played
-* @param int DIM - indicates the size of the board being solved
+* @param lpVars *vars - the model variables
 * @return int - returns 0 on success or 1 o/w
 */
-int getILPSolution(GRBenv *env, GRBmodel *model, double* resBoard, sudokuGame* sGame, int DIM) {
-	int i, j, v, error;
+int getILPSolution(GRBenv *env, GRBmodel *model, double* resBoard, sudokuGame* sGame, lpVars *vars) {
+	int i, j, k, error=0, DIM=vars->length;
 
-	error = GRBgetdblattrarray(model, GRB_DBL_ATTR_X, 0, DIM*DIM*DIM,	resBoard);
+	if (vars->count>0)
+		error = GRBgetdblattrarray(model, GRB_DBL_ATTR_X, 0, vars->count, resBoard);
 	if (error) {
 		printf("ERROR %d GRBgetdblattrarray(): %s\n", error,GRBgeterrormsg(env));
 		return 1;
 	}
 	for (i = 0; i < DIM; i++) {
 		for (j = 0; j < DIM; j++) {
-			for (v = 0; v < DIM; v++) {
-				if (resBoard[i * DIM * DIM + j * DIM + v] == 1)
-					sGame->currSol[i][j] = v + 1;
-			}
+			sGame->currSol[i][j] = CELL(sGame->currBoard,i,j).value;
 		}
 	}
+	for (k = 0; k < vars->count; k++) {
+		if (resBoard[k] > 0.5)
+			sGame->currSol[(vars->pair[k]/DIM)/DIM][(vars->pair[k]/DIM)%DIM] = vars->pair[k]%DIM + 1;
+	}
 	return 0;
 }
 
@@ -282,157 +563,91 @@ int getILPSolution(GRBenv *env, GRBmodel *model, double* resBoard, sudokuGame* s
 * @return int - 1 if LP was successful , 0 o\w
 */
 int LPSolverGuess(sudokuGame *sGame,double x){
-    int SUBDIMROW,SUBDIMCOL,DIM;
-    GRBenv *env = NULL;
-    GRBmodel *model = NULL;
-    double *lb=NULL,*val=NULL,*resBoard=NULL,*obj=NULL,objval;
-    char *vtype=NULL;
-    int i,j,v,error=0,optimstatus, *ind = NULL;
-    SUBDIMROW = sGame->currBoard->rowsInBlock , SUBDIMCOL = sGame->currBoard->colsInBlock;
-    DIM = sGame->currBoard->length;
+    double *scores = allocateGuessScores(sGame->currBoard->length);
+    int error;
+    error = guessScores(sGame,scores);
+    if (!error)
+        applyGuessScores(sGame,scores,x,&sGame->rng);
+    free(scores);
+    return error ? 0 : 1;
+}
 
-    /*allocate memory for all auxiliary arrays*/
-    allocateMemoryGRB(DIM,&lb,&val,&resBoard,&vtype,&ind,&obj,'L');
-
-    /* Create an empty model */
-    for (i = 0; i < DIM; i++) {
-        for (j = 0; j < DIM; j++) {
-            for (v = 0; v < DIM; v++) {
-                if (sGame->currBoard->board[i][j].value == v+1)
-                    lb[i*DIM*DIM+j*DIM+v] = 1;
-                else
-                    lb[i*DIM*DIM+j*DIM+v] = 0;
-                vtype[i*DIM*DIM+j*DIM+v] = GRB_CONTINUOUS;
-            }
-        }
+/**  guessScores:
+* @brief Brings the session's live LP model up to date with the board , optimizes it and gets its guess scores
+* @param sudokuGame *sGame - a pointer to the sudoku game being played
+* @param double *scores - gets the scores (see allocateGuessScores)
+* @return int - returns 0 on success or 1 o/w
+*/
+int guessScores(sudokuGame *sGame,double *scores){
+    lpSession *lp = NULL;
+    double *resBoard=NULL,objval;
+    int error=0,optimstatus;
+
+    /* Bring the session's live model up to date with the board */
+    if(getLiveModel(sGame,&lp))
+        return 1;
+    resBoard = (double *) malloc((lp->vars.count+1)*sizeof(double));
+    if(resBoard==NULL){
+        printf("Error: memory allocation failed\n");
+        exit(0);
     }
 
-    /*Randomize coefficients for the objective value)*/
-    randomizeCoefs(obj,DIM);
-
-    /* Create environment */
-    error = GRBloadenv(&env, "sudokuLP.log");
+    /* Optimize model - warm started from the last basis */
+    error = GRBoptimize(lp->model);
     if (error) goto QUIT;
-    error = GRBsetintparam(env, GRB_INT_PAR_LOGTOCONSOLE, 0);
-    if (error) goto QUIT;
-
 
-    /* Create new model */
-    error = GRBnewmodel(env, &model, "sudoku", DIM*DIM*DIM, obj, lb, NULL,vtype, NULL);
-    if (error) goto QUIT;
-
-    /* Change objective sense to maximization */
-    error = GRBsetintattr(model, GRB_INT_ATTR_MODELSENSE, GRB_MAXIMIZE);
-    if (error) goto QUIT;
-
-    /* update the model - to integrate new variables */
-    error = GRBupdatemodel(model);
-    if (error) goto QUIT;
-
-    /*Add sudokuBoard constraints*/
-    error = addConstraints(model,ind,val,DIM,SUBDIMROW,SUBDIMCOL,'L');
-    if (error) goto QUIT;
-
-    /* Optimize model */
-    error = GRBoptimize(model);
-    if (error) goto QUIT;
-
-    /* Write model to 'sudoku.lp' */
-    error = GRBwrite(model, "sudokuLP.lp");
+    /* Write model to 'sudokuLP.lp' if asked to */
+    error = writeModel(sGame, lp->model, LP_MODEL_FILE);
     if (error) goto QUIT;
 
     /* Capture solution information */
-    error = GRBgetintattr(model, GRB_INT_ATTR_STATUS, &optimstatus);
+    error = GRBgetintattr(lp->model, GRB_INT_ATTR_STATUS, &optimstatus);
     if (error) goto QUIT;
-    error = GRBgetdblattr(model, GRB_DBL_ATTR_OBJVAL, &objval);
+    error = GRBgetdblattr(lp->model, GRB_DBL_ATTR_OBJVAL, &objval);
     if (error) goto QUIT;
 
     /*Getting solution*/
-    error = getGuess(env,model,resBoard,sGame,DIM,x);
+    error = getScores(lp,resBoard,scores);
     if (error) goto QUIT;
 
-
     QUIT: /* Error reporting */
-    if (error){
-        freeMemoryGRB(ind,vtype,resBoard,val,lb,obj,'I');
-        GRBfreemodel(model);
-        GRBfreeenv(env);
-        return 0;
-    }
-    freeMemoryGRB(ind,vtype,resBoard,val,lb,obj,'L');
-    GRBfreemodel(model);
-    GRBfreeenv(env);
-    return 1;
-
+    free(resBoard);
+    return error ? 1 : 0;
 }
 
 /**  randomizeCoefs:
 * @brief Randomizes and sets an objective function for the LP program
 * @param double *obj - array that represents the objective function for LP solver
+* @param int count - number of model variables
 * @param int DIM - indicates the size of the board being solved
+* @param rngState *rng - the generator the coefficients are drawn from
 * @return void
 */
-void randomizeCoefs(double *obj,int DIM){
-    int i,j,v;
-    for (i = 0; i < DIM; i++) {
-            for (j = 0; j < DIM; j++) {
-                for (v = 0; v < DIM; v++) {
-                    obj[i*DIM*DIM + j*DIM + v]=rand()%(2*DIM);
-                }
-            }
-        }
+void randomizeCoefs(double *obj,int count,int DIM,rngState *rng){
+    int k;
+    for (k = 0; k < count; k++) {
+        obj[k]=rngBelow(rng,2*DIM);
+    }
 }
 
-/**  getGuess:
-* @brief Generates from the Gurobi model guesses for each cell and sets relevant cells in the game board
-* @param GRBenv *env - a pointer to the Gurobi environment used to solve the board
-* @param GRBmodel *resBoard - array that will get the result of the Gurobi model
-* @param sudokuGame *sGame - a pointer to the sudoku game being played
-* @param int DIM - indicates the size of the board being solved
-* @param double x - a threshold number for setting guesses to the board
+/**  getScores:
+* @brief Gets the LP values of the model variables as guess scores of their (cell,value) pairs
+* @param lpSession *session - the session holding the optimized live model
+* @param double* resBoard - array that will get the result of the Gurobi model
+* @param double *scores - gets the scores (see allocateGuessScores) , pairs without a variable score 0
 * @return int - returns 0 on success or 1 o/w
 */
-int getGuess(GRBenv *env,GRBmodel *model,double *resBoard, sudokuGame *sGame,int DIM,double x){
-	int i, j, v, count,countValues,k, error;
-	int *values;
+int getScores(lpSession *session,double *resBoard,double *scores){
+	int k, error=0;
 
-	error = GRBgetdblattrarray(model, GRB_DBL_ATTR_X, 0,DIM*DIM*DIM,resBoard);
+	if (session->vars.count>0)
+		error = GRBgetdblattrarray(session->model, GRB_DBL_ATTR_X, 0,session->vars.count,resBoard);
 	if (error) {
-		printf("ERROR %d GRBgetdblattrarray(): %s\n", error,GRBgeterrormsg(env));
+		printf("ERROR %d GRBgetdblattrarray(): %s\n", error,GRBgeterrormsg(session->env));
 		return 1;
 	}
-	/*PUSH MOVE FOR MULTI-CELL MOVE*/
-    pushGameMove(sGame);
-	for (i = 0; i < DIM; i++) {
-		for (j = 0; j < DIM; j++) {
-			count=0;
-			countValues=0;
-			for(v=0;v<DIM;v++){
-                if((resBoard[i * DIM * DIM + j * DIM + v]>x) && isLegalValue(sGame->currBoard,i,j,v)){
-                    count++;
-                    countValues += (int)(resBoard[i * DIM * DIM + j * DIM + v]*10);
-                }
-			}
-			values = (int *)malloc(countValues*sizeof(int));
-			if(values==NULL){
-                printf("Error: memory allocation has failed\n");
-                exit(0);
-			}
-			for(v=0;v<countValues;v++){
-                values[v]=0;
-			}
-			for(v=0;v<DIM;v++){
-                if(resBoard[i * DIM * DIM + j * DIM + v]>x && isLegalValue(sGame->currBoard,i,j,v))
-                    for(k=0;k<(int)(resBoard[i * DIM * DIM + j * DIM + v]*10);k++)
-                        values[k]=v;
-			}
-            if(count>0){
-                int index;
-                index = rand()%countValues;
-                gameSetCell(sGame,i,j,values[index]+1,1);
-            }
-			free(values);
-		}
+	for (k = 0; k < session->vars.count; k++) {
+		scores[session->vars.pair[k]] = resBoard[k];
 	}
     return 0;
 }
@@ -444,97 +659,11 @@ int getGuess(GRBenv *env,GRBmodel *model,double *resBoard, sudokuGame *sGame,int
 * @return int - 1 if LP was successful , 0 o\w
 */
 int LPSolverGuessHint(sudokuGame *sGame,int row,int col){
-    int SUBDIMROW,SUBDIMCOL,DIM;
-    GRBenv *env = NULL;
-    GRBmodel *model = NULL;
-    double *lb=NULL,*val=NULL,*resBoard=NULL,*obj=NULL,objval;
-    char *vtype=NULL;
-    int i,j,v,error=0,optimstatus, *ind = NULL;
-    SUBDIMROW = sGame->currBoard->rowsInBlock , SUBDIMCOL = sGame->currBoard->colsInBlock;
-    DIM = sGame->currBoard->length;
-
-    /*allocate memory for all auxiliary arrays*/
-    allocateMemoryGRB(DIM,&lb,&val,&resBoard,&vtype,&ind,&obj,'L');
-
-    /* Create an empty model */
-    for (i = 0; i < DIM; i++) {
-        for (j = 0; j < DIM; j++) {
-            for (v = 0; v < DIM; v++) {
-                if (sGame->currBoard->board[i][j].value == v+1)
-                    lb[i*DIM*DIM+j*DIM+v] = 1;
-                else
-                    lb[i*DIM*DIM+j*DIM+v] = 0;
-                vtype[i*DIM*DIM+j*DIM+v] = GRB_CONTINUOUS;
-            }
-        }
-    }
-
-    /*Randomize coefficients for the objective value)*/
-    randomizeCoefs(obj,DIM);
-
-    /* Create environment */
-    error = GRBloadenv(&env, "sudokuLP.log");
-    if (error) goto QUIT;
-    error = GRBsetintparam(env, GRB_INT_PAR_LOGTOCONSOLE, 0);
-    if (error) goto QUIT;
-
-
-    /* Create new model */
-    error = GRBnewmodel(env, &model, "sudoku", DIM*DIM*DIM, obj, lb, NULL,vtype, NULL);
-    if (error) goto QUIT;
-
-    /* Change objective sense to maximization */
-    error = GRBsetintattr(model, GRB_INT_ATTR_MODELSENSE, GRB_MAXIMIZE);
-    if (error) goto QUIT;
-
-    /* update the model - to integrate new variables */
-    error = GRBupdatemodel(model);
-    if (error) goto QUIT;
-
-    /*Add sudokuBoard constraints*/
-    error = addConstraints(model,ind,val,DIM,SUBDIMROW,SUBDIMCOL,'L');
-    if (error) goto QUIT;
-
-    /* Optimize model */
-    error = GRBoptimize(model);
-    if (error) goto QUIT;
-
-    /* Write model to 'sudoku.lp' */
-    error = GRBwrite(model, "sudokuLP.lp");
-    if (error) goto QUIT;
-
-    /* Capture solution information */
-    error = GRBgetintattr(model, GRB_INT_ATTR_STATUS, &optimstatus);
-    if (error) goto QUIT;
-    error = GRBgetdblattr(model, GRB_DBL_ATTR_OBJVAL, &objval);
-    if (error) goto QUIT;
-
-    /*Getting solution*/
-	error = GRBgetdblattrarray(model, GRB_DBL_ATTR_X, 0,DIM*DIM*DIM,resBoard);
-	if (error) {
-		printf("ERROR %d GRBgetdblattrarray(): %s\n", error,GRBgeterrormsg(env));
-		return 1;
-	}
-	printf("Valid values options for cell <%d,%d> are\n",col+1,row+1);
-	for(v=0;v<DIM;v++){
-        if(resBoard[row*DIM*DIM + col*DIM + v]>0 && isLegalValue(sGame->currBoard,row,col,v)){
-            printf("Chances for value %d is %.2f\n",v+1,resBoard[row*DIM*DIM + col*DIM + v]);
-        }
-	}
-
-    QUIT: /* Error reporting */
-    if (error){
-        freeMemoryGRB(ind,vtype,resBoard,val,lb,obj,'L');
-        GRBfreemodel(model);
-        GRBfreeenv(env);
-        return 0;
-    }
-    freeMemoryGRB(ind,vtype,resBoard,val,lb,obj,'L');
-    GRBfreemodel(model);
-    GRBfreeenv(env);
-    return 1;
-
+    double *scores = allocateGuessScores(sGame->currBoard->length);
+    int error;
+    error = guessScores(sGame,scores);
+    if (!error)
+        printGuessScores(sGame,scores,row,col);
+    free(scores);
+    return error ? 0 : 1;
 }
-
-
-
@@ -6,5 +6,6 @@
 int ILPSolver(sudokuGame *sGame);
 int LPSolverGuess(sudokuGame *sGame,double x);
 int LPSolverGuessHint(sudokuGame *sGame,int row,int col);
+void LPSolverRelease(sudokuGame *sGame);
 
 #endif
@@ -1,17 +1,27 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "SudokuBoard.h"
 
 /*Private functions declarations, all are auxiliary to setCell*/
 void writeCell(sudokuBoard *sBoard,int row,int col,int block,int value);
 void clearCell(sudokuBoard *sBoard,int row,int col,int block,int value);
-void markErrors(sudokuBoard *sBoard,int index,int value,char type);
-void rowClearCleanup(sudokuBoard *sBoard,int row,int prevVal);
-void colClearCleanup(sudokuBoard *sBoard,int col,int prevVal);
-void blockClearCleanup(sudokuBoard *sBoard,int block,int prevVal);
+int addToUnit(sudokuBoard *sBoard,int tableIndex,int unit,int val,int cellIndex);
+void removeFromUnit(sudokuBoard *sBoard,int tableIndex,int unit,int val,int cellIndex);
+void changeConflicts(sudokuBoard *sBoard,int cellIndex,int delta);
+void journalCell(sudokuBoard *sBoard,int row,int col);
+void journalUnit(sudokuBoard *sBoard,int slot);
+void setErrorFlag(sudokuBoard *sBoard,int row,int col,int flag);
+unitSet *slotWord(sudokuBoard *sBoard,int slot);
+/*Auxiliary to randomizeLegalValue*/
+unitSet legalWord(sudokuBoard *sBoard,int row,int col,int w);
+int unitPopCount(unitSet word);
 /*Debug Methods*/
 void printInvalids(sudokuBoard *sBoard,char type);
 
+/* The last version stamp given to a board (see boardCounts) */
+unsigned long lastBoardVersion = 0;
+
 /**  print_board:
 * @brief Prints a sudoku board in the required format
 * @param sudokuBoard *pBoard - a pointer to the board needed to be printed
@@ -42,12 +52,12 @@ void print_board(sudokuBoard *pBoard,int markErrors) {
                 printf("|");
             }
             printf(" ");
-            if (pBoard->board[i][j].fixed == 1) {
-                printf("%2d.", pBoard->board[i][j].value);
+            if (CELL(pBoard,i,j).fixed == 1) {
+                printf("%2d.", CELL(pBoard,i,j).value);
             } else {
-                if (pBoard->board[i][j].value != 0) {
-                    printf("%2d", pBoard->board[i][j].value);
-                    if(markErrors && pBoard->board[i][j].errorFlag){
+                if (CELL(pBoard,i,j).value != 0) {
+                    printf("%2d", CELL(pBoard,i,j).value);
+                    if(markErrors && CELL(pBoard,i,j).errorFlag){
                         printf("*");
                     } else{
                         printf(" ");
@@ -73,37 +83,33 @@ void print_board(sudokuBoard *pBoard,int markErrors) {
 * @return void
 */
 void get_empty_board(sudokuBoard *sBoard,int m, int n) {
-    int i, j;
     int len = m*n;
-    sBoard->board = (Cell **) calloc(len,sizeof(Cell *));
-    sBoard->invalidRows = (int **) calloc(len,sizeof(int *));
-    sBoard->invalidCols = (int **) calloc(len,sizeof(int *));
-    sBoard->invalidBlocks = (int **) calloc(len,sizeof(int *));
-    if (sBoard->board == NULL || sBoard->invalidRows == NULL || sBoard->invalidCols == NULL || sBoard->invalidBlocks == NULL) {
-        puts("Error: empty board malloc has failed in get_empty_board, Exiting...");
-        exit(0);
-    }
-    for (i = 0; i <len ; i++) {
-        sBoard->board[i] = calloc(len,sizeof(Cell));
-        sBoard->invalidRows[i] = calloc(len,sizeof(int));
-        sBoard->invalidCols[i] = calloc(len,sizeof(int));
-        sBoard->invalidBlocks[i] = calloc(len,sizeof(int));
-        if (sBoard->board[i] == NULL || sBoard->invalidRows[i] == NULL || sBoard->invalidCols[i] == NULL || sBoard->invalidBlocks[i] == NULL) {
-            puts("Error: empty board malloc has failed in get_empty_board, Exiting...");
-            exit(0);
-        }
-    }
-    for (i = 0; i < len; i++) {
-        for (j = 0; j < len; j++) {
-            sBoard->board[i][j].value = 0;
-            sBoard->board[i][j].fixed = 0;
-            sBoard->board[i][j].errorFlag = 0;
-            sBoard->board[i][j].userMod = 0;
-        }
-    }
+    size_t countsSize,setsSize,cellsSize,slots;
     sBoard->colsInBlock = n;
     sBoard->rowsInBlock = m;
     sBoard->length = len;
+    sBoard->unitWords = (len+UNIT_SET_BITS-1)/UNIT_SET_BITS;
+    /*Counts padded to a whole bitset word and bitsets before the cells, so everything stays aligned*/
+    countsSize = ((sizeof(boardCounts)+sizeof(unitSet)-1)/sizeof(unitSet))*sizeof(unitSet);
+    setsSize = 3*len*sBoard->unitWords*sizeof(unitSet);
+    cellsSize = len*len*sizeof(Cell);
+    slots = 3*len*len;
+    sBoard->imageSize = countsSize + setsSize + cellsSize + slots*(sizeof(unsigned short)+sizeof(unsigned char));
+    sBoard->image = calloc(1,sBoard->imageSize);
+    if (sBoard->image == NULL) {
+        puts("Error: empty board malloc has failed in get_empty_board, Exiting...");
+        exit(0);
+    }
+    sBoard->counts = (boardCounts *) sBoard->image;
+    sBoard->invalidRows = (unitSet *) ((char *) sBoard->image + countsSize);
+    sBoard->invalidCols = sBoard->invalidRows + len*sBoard->unitWords;
+    sBoard->invalidBlocks = sBoard->invalidCols + len*sBoard->unitWords;
+    sBoard->cells = (Cell *) ((char *) sBoard->invalidRows + setsSize);
+    sBoard->holders = (unsigned short *) ((char *) sBoard->cells + cellsSize);
+    sBoard->occurrences = (unsigned char *) (sBoard->holders + slots);
+    sBoard->counts->emptyCells = len*len;
+    sBoard->counts->version = ++lastBoardVersion;
+    sBoard->journal = NULL;
 }
 
 /**  freeBoard:
@@ -112,20 +118,11 @@ void get_empty_board(sudokuBoard *sBoard,int m, int n) {
 * @return void
 */
 void freeBoard(sudokuBoard *sBoard) {
-    int i;
     if(sBoard == NULL){
         return;
     }
-    for (i = 0; i < sBoard->length; i++) {
-        free(sBoard->board[i]);
-        free(sBoard->invalidRows[i]);
-        free(sBoard->invalidCols[i]);
-        free(sBoard->invalidBlocks[i]);
-    }
-    free(sBoard->invalidBlocks);
-    free(sBoard->invalidCols);
-    free(sBoard->invalidRows);
-    free(sBoard->board);
+    unmarkBoard(sBoard);
+    free(sBoard->image);
     free(sBoard);
 }
 
@@ -139,13 +136,13 @@ void freeBoard(sudokuBoard *sBoard) {
 int isLegalValue(sudokuBoard *sBoard,int row,int col,int val){
     int block;
     block = (sBoard->rowsInBlock)*(row/sBoard->rowsInBlock)+(col/sBoard->colsInBlock);
-    if(sBoard->board[row][col].fixed==1 || sBoard->board[row][col].userMod==1)
+    if(CELL(sBoard,row,col).fixed==1 || CELL(sBoard,row,col).userMod==1)
         return 0;
-    if(sBoard->invalidRows[row][val]==1)
+    if(UNIT_HAS(sBoard,invalidRows,row,val))
         return 0;
-    if(sBoard->invalidCols[col][val]==1)
+    if(UNIT_HAS(sBoard,invalidCols,col,val))
         return 0;
-    if(sBoard->invalidBlocks[block][val]==1)
+    if(UNIT_HAS(sBoard,invalidBlocks,block,val))
         return 0;
     return 1;
 }
@@ -156,15 +153,7 @@ int isLegalValue(sudokuBoard *sBoard,int row,int col,int val){
 * @return int - 1 if the board is erroneous , 0 o\w
 */
 int isBoardError(sudokuBoard *sBoard){
-    int i,j,len;
-    len=sBoard->length;
-    for(i=0;i<len;i++){
-        for(j=0;j<len;j++){
-            if(sBoard->board[i][j].errorFlag==1)
-                return 1;
-        }
-    }
-    return 0;
+    return sBoard->counts->errorCells>0;
 }
 
 /**  isFixedCellsLegal:
@@ -173,15 +162,7 @@ int isBoardError(sudokuBoard *sBoard){
 * @return int - 1 if the board is erroneous , 0 o\w
 */
 int isFixedCellsLegal(sudokuBoard *sBoard){
-    int i,j,len;
-    len=sBoard->length;
-    for(i=0;i<len;i++){
-        for(j=0;j<len;j++){
-            if(sBoard->board[i][j].errorFlag==1 && sBoard->board[i][j].fixed ==1 )
-                return 0;
-        }
-    }
-    return 1;
+    return sBoard->counts->fixedErrorCells==0;
 }
 
 /**  clearAllFixedCells:
@@ -194,88 +175,163 @@ void clearAllFixedCells(sudokuBoard *sBoard){
     len=sBoard->length;
     for(i=0;i<len;i++){
         for(j=0;j<len;j++){
-            sBoard->board[i][j].fixed=0;
+            CELL(sBoard,i,j).fixed=0;
         }
     }
+    sBoard->counts->fixedErrorCells=0;
+}
+
+/**  setCellFixed:
+* @brief Fixes or unfixes a cell of the game board , keeping the board's counts up to date
+* @param sudokuBoard *sBoard - a pointer to the board played
+* @param int row/col - indicates the cell's location in the board (0-based)
+* @param int fixed - 1 to fix the cell , 0 to unfix it
+* @return void
+*/
+void setCellFixed(sudokuBoard *sBoard,int row,int col,int fixed){
+    if(CELL(sBoard,row,col).fixed==fixed)
+        return;
+    journalCell(sBoard,row,col);
+    CELL(sBoard,row,col).fixed=fixed;
+    if(CELL(sBoard,row,col).errorFlag)
+        sBoard->counts->fixedErrorCells += fixed ? 1 : -1;
 }
 
 /**  countEmptyCells:
-* @brief Counts the number of empty cells in the game board
+* @brief Counts the number of empty cells in the game board (fixed cells always hold a value)
 * @param sudokuBoard *sBoard - a pointer to the board played
 * @return int - specified count
 */
 int countEmptyCells(sudokuBoard *sBoard){
-    int count=0,i,j;
-    for(i=0;i<sBoard->length;i++){
-        for(j=0;j<sBoard->length;j++){
-            if(sBoard->board[i][j].fixed==0 && sBoard->board[i][j].value==0)
-                count++;
-        }
-    }
-    return count;
+    return sBoard->counts->emptyCells;
+}
+
+/**  boardVersion:
+* @brief Gets the version stamp of the board's cell values - equal stamps mean equal values (copies and rollbacks keep the stamp of what they restore)
+* @param sudokuBoard *sBoard - a pointer to the board played
+* @return unsigned long - the board's version
+*/
+unsigned long boardVersion(sudokuBoard *sBoard){
+    return sBoard->counts->version;
 }
 
 /**  randomizeLegalValue:
 * @brief Randomizes a legal value for a cell in the game board from all valid values
 * @param sudokuBoard *sBoard - a pointer to the board played
 * @param int row/col - indicates the cell's location in the board (0-based)
+* @param rngState *rng - the generator the value is drawn from
 * @return int - the randomized legal value (1-based) or -1 if there are none
 */
-int randomizeLegalValue(sudokuBoard *sBoard,int row,int col){
-    int *values, N,v,count=0;
-    N=sBoard->length;
-    values = (int*)malloc(N*sizeof(int));
-    if(values==NULL){
-        printf("Error: memory allocation has failed in randomizeLegalValue,Exiting...\n");
-        exit(0);
-    }
-    for(v=0;v<N;v++){
-        if(isLegalValue(sBoard,row,col,v)){
-            values[v]=1;
-            count++;
-        }
-        else{
-            values[v]=0;
-        }
-    }
-    if(count==0){/*No legal values available*/
-        free(values);
+int randomizeLegalValue(sudokuBoard *sBoard,int row,int col,rngState *rng){
+    int w,k,count=0;
+    unitSet legal;
+    if(CELL(sBoard,row,col).fixed==1 || CELL(sBoard,row,col).userMod==1)
         return -1;
-    }
-    else{
-        while(1){
-            v = rand()%N;
-            if(values[v]==1){
-                free(values);
-                return (v+1);
-            }
-        }
-    }
-    free(values);
-    return -1;
+    for(w=0;w<sBoard->unitWords;w++)
+        count += unitPopCount(legalWord(sBoard,row,col,w));
+    if(count==0)/*No legal values available*/
+        return -1;
+    k = rngBelow(rng,count);
+    for(w=0;;w++){
+        legal = legalWord(sBoard,row,col,w);
+        count = unitPopCount(legal);
+        if(k<count)
+            break;
+        k -= count;
+    }
+    while(k-->0)/*Drop the k lower legal values of the word*/
+        legal &= legal-1;
+    for(k=0;!((legal>>k)&1UL);k++);
+    return (int)(w*UNIT_SET_BITS)+k+1;
 }
 
 /**  copy_boards:
 * @brief Copies all content of a board to a different board
 * @param sudokuBoard *oldBoard - a pointer to the board getting a new copy
-* @param sudokuBoard *newBoard - a pointer to the board who will hold the copy of oldBoard
+* @param sudokuBoard *newBoard - a pointer to the board who will hold the copy of oldBoard (same dimensions as oldBoard , its journal is left alone)
 * @return void
 */
 void copy_boards(sudokuBoard *oldBoard , sudokuBoard *newBoard){
-    int i,j,N;
-    N=oldBoard->length;
-    for(i=0;i<N;i++){
-        for(j=0;j<N;j++){
-            newBoard->board[i][j].value=oldBoard->board[i][j].value;
-            newBoard->board[i][j].fixed=oldBoard->board[i][j].fixed;
-            newBoard->board[i][j].errorFlag=oldBoard->board[i][j].errorFlag;
-            newBoard->board[i][j].userMod=oldBoard->board[i][j].userMod;
-            newBoard->invalidRows[i][j]=oldBoard->invalidRows[i][j];
-            newBoard->invalidCols[i][j]=oldBoard->invalidCols[i][j];
-            newBoard->invalidBlocks[i][j]=oldBoard->invalidBlocks[i][j];
+    memcpy(newBoard->image,oldBoard->image,oldBoard->imageSize);
+    return;
+}
+
+/**  cloneBoard:
+* @brief Creates a new board holding a snapshot of a board (a single block copy of its image)
+* @param sudokuBoard *sBoard - a pointer to the board being copied
+* @return sudokuBoard* - the new board (unmarked) , free with freeBoard. Restore from it with copy_boards
+*/
+sudokuBoard *cloneBoard(sudokuBoard *sBoard){
+    sudokuBoard *newBoard;
+    newBoard = (sudokuBoard *) malloc(sizeof(sudokuBoard));
+    if(newBoard==NULL){
+        printf("Error: memory allocation has failed in cloneBoard, Exiting...\n");
+        exit(0);
+    }
+    get_empty_board(newBoard,sBoard->rowsInBlock,sBoard->colsInBlock);
+    copy_boards(sBoard,newBoard);
+    return newBoard;
+}
+
+/**  markBoard:
+* @brief Marks the current state of a board - from now on setCell and setCellFixed journal every cell and (unit,value) slot they change
+* @param sudokuBoard *sBoard - a pointer to the board played
+* @return void
+*/
+void markBoard(sudokuBoard *sBoard){
+    if(sBoard->journal==NULL){
+        sBoard->journal = (boardJournal *) calloc(1,sizeof(boardJournal));
+        if(sBoard->journal==NULL){
+            printf("Error: memory allocation has failed in markBoard, Exiting...\n");
+            exit(0);
         }
     }
-    return;
+    sBoard->journal->cellCount = 0;
+    sBoard->journal->unitCount = 0;
+    sBoard->journal->markCounts = *sBoard->counts;
+}
+
+/**  rollbackBoard:
+* @brief Brings a marked board back to its state at the mark , in time proportional to the changes made since
+* @param sudokuBoard *sBoard - a pointer to the marked board (stays marked)
+* @return void
+*/
+void rollbackBoard(sudokuBoard *sBoard){
+    boardJournal *journal = sBoard->journal;
+    unitRecord *record;
+    int i;
+    if(journal==NULL){
+        return;
+    }
+    /*Newest first, so a cell journaled more than once ends up with its oldest contents*/
+    for(i=journal->cellCount-1;i>=0;i--){
+        sBoard->cells[journal->cellIndex[i]] = journal->cellPrev[i];
+    }
+    for(i=journal->unitCount-1;i>=0;i--){
+        record = &journal->units[i];
+        sBoard->occurrences[record->slot] = record->occurrences;
+        sBoard->holders[record->slot] = record->holders;
+        *slotWord(sBoard,record->slot) = record->word;
+    }
+    *sBoard->counts = journal->markCounts;
+    journal->cellCount = 0;
+    journal->unitCount = 0;
+}
+
+/**  unmarkBoard:
+* @brief Stops journaling the changes to a board and frees the journal
+* @param sudokuBoard *sBoard - a pointer to the board played
+* @return void
+*/
+void unmarkBoard(sudokuBoard *sBoard){
+    if(sBoard->journal==NULL){
+        return;
+    }
+    free(sBoard->journal->cellIndex);
+    free(sBoard->journal->cellPrev);
+    free(sBoard->journal->units);
+    free(sBoard->journal);
+    sBoard->journal = NULL;
 }
 
 /**  find_empty_cell:
@@ -290,7 +346,7 @@ Index_Pair find_empty_cell(sudokuBoard *sBoard){
     ip.x=-1,ip.y=-1;
     for(i=0;i<len;i++){
         for(j=0;j<len;j++){
-            if ((sBoard->board[i][j].fixed==0) && (sBoard->board[i][j].value==0)){
+            if ((CELL(sBoard,i,j).fixed==0) && (CELL(sBoard,i,j).value==0)){
                 ip.x = i;
                 ip.y = j;
                 return ip;
@@ -310,8 +366,8 @@ Index_Pair find_empty_cell(sudokuBoard *sBoard){
 int setCell(sudokuBoard *sBoard,int row,int col,int value){
     int block,prevVal, ROWS=sBoard->rowsInBlock,COLS=sBoard->colsInBlock;
     block = ROWS*(row/ROWS) + (col/COLS);
-    prevVal = sBoard->board[row][col].value;
-    if(sBoard->board[row][col].fixed==1){
+    prevVal = CELL(sBoard,row,col).value;
+    if(CELL(sBoard,row,col).fixed==1){
         printf("Error: can't set a fixed cell\n");
         return 0;
     }
@@ -337,70 +393,24 @@ int setCell(sudokuBoard *sBoard,int row,int col,int value){
 /**  writeCell:
 * @brief Changes a cell in the game board from 0 to value (ranged 1-N)
 * @param sudokuBoard *sBoard - a pointer to the board played
-* @param int row/col - indicates the cell's location in the board (0-based)
+* @param int row/col/block - indicates the cell's location in the board (0-based)
 * @param int val - the value being check for validity (1-based)
 * @return void
 */
 void writeCell(sudokuBoard *sBoard,int row,int col,int block,int value){
+    int cellIndex = row*sBoard->length+col,conflicts;
+    journalCell(sBoard,row,col);
     /*MUSTS*/
-    sBoard->board[row][col].value=value;
-    sBoard->board[row][col].userMod=1;
-    /*OPTIONAL*/
-    /*Row check*/
-    if(sBoard->invalidRows[row][value-1]==1){
-        markErrors(sBoard,row,value,'R');
-    }else{sBoard->invalidRows[row][value-1]=1;}
-    /*Column check*/
-    if(sBoard->invalidCols[col][value-1]==1){
-        markErrors(sBoard,col,value,'C');
-    }else{sBoard->invalidCols[col][value-1]=1;}
-    /*Block check*/
-    if(sBoard->invalidBlocks[block][value-1]==1){
-        markErrors(sBoard,block,value,'B');
-    }else{sBoard->invalidBlocks[block][value-1]=1;}
-}
-
-/**  markErrors:
-* @brief After a write to a cell , mark all new erroneous cells (if any)
-* @param sudokuBoard *sBoard - a pointer to the board played
-* @param int index - index of the row/column/block needed checked
-* @param char type - differs for checking 'R' - row , 'C' - column or 'B' - block
-* @return void
-*/
-void markErrors(sudokuBoard *sBoard,int index,int value,char type){
-    int i,ROWS,COLS,N=sBoard->length;
-    int rowStart,rowEnd,colStart,colEnd,j;
-    ROWS = sBoard->rowsInBlock,COLS = sBoard->colsInBlock;
-    switch (type){
-    case 'R':
-        for(i=0;i<N;i++){
-            if(sBoard->board[index][i].value==value){
-                sBoard->board[index][i].errorFlag=1;
-            }
-        }
-        break;
-    case 'C':
-        for(i=0;i<N;i++){
-            if(sBoard->board[i][index].value==value){
-                sBoard->board[i][index].errorFlag=1;
-            }
-        }
-        break;
-    case 'B':
-        rowStart = (index/ROWS)*ROWS , rowEnd = (((index/ROWS)+1)*ROWS)-1;
-        colStart = (index%ROWS)*COLS , colEnd = (((index%ROWS)+1)*COLS)-1;
-        for(i=rowStart;i<=rowEnd;i++){
-            for(j=colStart;j<=colEnd;j++){
-                if(sBoard->board[i][j].value==value){
-                    sBoard->board[i][j].errorFlag=1;
-                }
-            }
-        }
-        break;
-    default:
-        printf("Error: no such type -%c- while marking errors\n",type);
-    }
-    return;
+    CELL(sBoard,row,col).value=value;
+    CELL(sBoard,row,col).userMod=1;
+    sBoard->counts->emptyCells--;
+    sBoard->counts->version = ++lastBoardVersion;
+    /*Errors - the cell conflicts in every unit already holding value*/
+    conflicts = addToUnit(sBoard,0,row,value-1,cellIndex);
+    conflicts += addToUnit(sBoard,1,col,value-1,cellIndex);
+    conflicts += addToUnit(sBoard,2,block,value-1,cellIndex);
+    CELL(sBoard,row,col).conflicts=conflicts;
+    setErrorFlag(sBoard,row,col,conflicts>0);
 }
 
 /**  clearCell:
@@ -411,150 +421,195 @@ void markErrors(sudokuBoard *sBoard,int index,int value,char type){
 * @return void
 */
 void clearCell(sudokuBoard *sBoard,int row,int col,int block,int prevVal){
+    int cellIndex = row*sBoard->length+col;
+    journalCell(sBoard,row,col);
     /*MUSTS*/
-    sBoard->board[row][col].value=0;
-    sBoard->board[row][col].userMod=0;
-    /*OPTIONAL*/
-    if(sBoard->board[row][col].errorFlag==0){
-        /*Cell is not errored*/
-        sBoard->invalidRows[row][prevVal-1]=0;
-        sBoard->invalidCols[col][prevVal-1]=0;
-        sBoard->invalidBlocks[block][prevVal-1]=0;
-    }
-    else{/*Cell is errored*/
-        sBoard->board[row][col].errorFlag=0;
-        /*NOTE: check if there's need to be an if statement : sBoard->invalidRows/Cols/Blocks[relevent index][prevVal-1]==1*/
-        rowClearCleanup(sBoard,row,prevVal);
-        colClearCleanup(sBoard,col,prevVal);
-        blockClearCleanup(sBoard,block,prevVal);
+    CELL(sBoard,row,col).value=0;
+    CELL(sBoard,row,col).userMod=0;
+    sBoard->counts->emptyCells++;
+    sBoard->counts->version = ++lastBoardVersion;
+    /*Errors - a lone remaining holder of prevVal in a unit stops conflicting there*/
+    removeFromUnit(sBoard,0,row,prevVal-1,cellIndex);
+    removeFromUnit(sBoard,1,col,prevVal-1,cellIndex);
+    removeFromUnit(sBoard,2,block,prevVal-1,cellIndex);
+    CELL(sBoard,row,col).conflicts=0;
+    setErrorFlag(sBoard,row,col,0);
+}
 
-    }
+/**  addToUnit:
+* @brief Counts a new holder of a value in a unit , and marks the value's former lone holder as conflicting (if any)
+* @param sudokuBoard *sBoard - a pointer to the board played
+* @param int tableIndex - 0 for a row , 1 for a column , 2 for a block
+* @param int unit - index of the row/column/block (0-based)
+* @param int val - the value (0-based)
+* @param int cellIndex - the new holder (row*N+col)
+* @return int - 1 if the value was already in the unit (the new holder conflicts there) , 0 o\w
+*/
+int addToUnit(sudokuBoard *sBoard,int tableIndex,int unit,int val,int cellIndex){
+    int slot = UNIT_SLOT(sBoard,tableIndex,unit,val);
+    unsigned char prevCount = sBoard->occurrences[slot];
+    journalUnit(sBoard,slot);
+    if(prevCount==0){
+        *slotWord(sBoard,slot) |= 1UL<<(val%UNIT_SET_BITS);
+    }
+    else if(prevCount==1){/*holders is the lone holder's index*/
+        changeConflicts(sBoard,sBoard->holders[slot],1);
+    }
+    sBoard->occurrences[slot] = prevCount+1;
+    sBoard->holders[slot] ^= (unsigned short)cellIndex;
+    return prevCount>0;
 }
 
-/**  rowClearCleanup:
-* @brief After a clear, update previously erroneous cells to non-erroneous (if any) in the cleared cell's row
+/**  removeFromUnit:
+* @brief Uncounts a holder of a value in a unit , and clears the conflict of the value's last remaining holder (if any)
 * @param sudokuBoard *sBoard - a pointer to the board played
-* @param int row- indicates the cell's row in the board (0-based)
-* @param int prevVal - the original value of the cell that is being cleared
+* @param int tableIndex - 0 for a row , 1 for a column , 2 for a block
+* @param int unit - index of the row/column/block (0-based)
+* @param int val - the value (0-based)
+* @param int cellIndex - the holder being removed (row*N+col)
 * @return void
 */
-void rowClearCleanup(sudokuBoard *sBoard,int row,int prevVal){
-    int count,sec_row,sec_col,i,j,noChange=0;
-    int ROWS=sBoard->rowsInBlock,COLS=sBoard->colsInBlock;
-    int rowStart,rowEnd,colStart,colEnd;
-    /*Check Row*/
-    count=0;
-    for(i=0;i<sBoard->length;i++){
-        if(sBoard->board[row][i].value==prevVal){
-            count++;
-            sec_row=row;sec_col=i;
-        }
-    }
-    if(count==0){
-        sBoard->invalidRows[row][prevVal-1]=0;
+void removeFromUnit(sudokuBoard *sBoard,int tableIndex,int unit,int val,int cellIndex){
+    int slot = UNIT_SLOT(sBoard,tableIndex,unit,val);
+    journalUnit(sBoard,slot);
+    sBoard->occurrences[slot]--;
+    sBoard->holders[slot] ^= (unsigned short)cellIndex;
+    if(sBoard->occurrences[slot]==0){
+        *slotWord(sBoard,slot) &= ~(1UL<<(val%UNIT_SET_BITS));
     }
-    rowStart = (sec_row/ROWS)*ROWS , rowEnd =((sec_row/ROWS)*ROWS)+ROWS-1 ;
-    colStart = (sec_col/COLS)*COLS , colEnd = ((sec_col/COLS)*COLS)+COLS-1;
-    if(count==1){
-        /*NEED TO CHECK COL AND BLOCK*/
-        for(i=0;i<sBoard->length;i++){
-            if(sBoard->board[i][sec_col].value==prevVal && i!=sec_row){
-                noChange=1;
-            }
-        }
-        for(i=rowStart;i<=rowEnd;i++){
-            for(j=colStart;j<=colEnd;j++){
-                if(sBoard->board[i][j].value==prevVal && i!=sec_row && j!=sec_col)
-                    noChange=1;
-            }
-        }
-        if(noChange!=1)
-            sBoard->board[sec_row][sec_col].errorFlag=0;
+    else if(sBoard->occurrences[slot]==1){/*holders is now the lone holder's index*/
+        changeConflicts(sBoard,sBoard->holders[slot],-1);
     }
 }
 
-/**  colClearCleanup:
-* @brief After a clear, update previously erroneous cells to non-erroneous (if any) in the cleared cell's column
+/**  changeConflicts:
+* @brief Changes the number of units a cell conflicts in , and its error flag accordingly
 * @param sudokuBoard *sBoard - a pointer to the board played
-* @param int col- indicates the cell's column in the board (0-based)
-* @param int prevVal - the original value of the cell that is being cleared
+* @param int cellIndex - the cell (row*N+col)
+* @param int delta - +1 or -1
 * @return void
 */
-void colClearCleanup(sudokuBoard *sBoard,int col,int prevVal){
-    int count,sec_row,sec_col,i,j,noChange=0;
-    int ROWS=sBoard->rowsInBlock,COLS=sBoard->colsInBlock;
-    int rowStart,rowEnd,colStart,colEnd;
-    /*Check Col*/
-    count=0;
-    for(i=0;i<sBoard->length;i++){
-        if(sBoard->board[i][col].value==prevVal){
-            count++;
-            sec_row=i;sec_col=col;
-        }
-    }
-    if(count==0){
-        sBoard->invalidCols[col][prevVal-1]=0;
+void changeConflicts(sudokuBoard *sBoard,int cellIndex,int delta){
+    int row = cellIndex/sBoard->length,col = cellIndex%sBoard->length;
+    journalCell(sBoard,row,col);
+    CELL(sBoard,row,col).conflicts += delta;
+    setErrorFlag(sBoard,row,col,CELL(sBoard,row,col).conflicts>0);
+}
+
+/**  setErrorFlag:
+* @brief Sets or clears the error flag of a cell , keeping the board's counts up to date
+* @param sudokuBoard *sBoard - a pointer to the board played
+* @param int row/col - indicates the cell's location in the board (0-based)
+* @param int flag - 1 if the cell is erroneous , 0 o\w
+* @return void
+*/
+void setErrorFlag(sudokuBoard *sBoard,int row,int col,int flag){
+    if(CELL(sBoard,row,col).errorFlag==flag)
+        return;
+    CELL(sBoard,row,col).errorFlag=flag;
+    sBoard->counts->errorCells += flag ? 1 : -1;
+    if(CELL(sBoard,row,col).fixed)
+        sBoard->counts->fixedErrorCells += flag ? 1 : -1;
+}
+
+/**  journalCell:
+* @brief Saves a cell's contents in the board's journal before it's changed (if the board is marked)
+* @param sudokuBoard *sBoard - a pointer to the board played
+* @param int row/col - indicates the cell's location in the board (0-based)
+* @return void
+*/
+void journalCell(sudokuBoard *sBoard,int row,int col){
+    boardJournal *journal = sBoard->journal;
+    if(journal==NULL){
+        return;
     }
-    rowStart = (sec_row/ROWS)*ROWS , rowEnd =((sec_row/ROWS)*ROWS)+ROWS-1 ;
-    colStart = (sec_col/COLS)*COLS , colEnd = ((sec_col/COLS)*COLS)+COLS-1;
-    if(count==1){
-        /*NEED TO CHECK ROW AND BLOCK*/
-        for(i=0;i<sBoard->length;i++){
-            if(sBoard->board[sec_row][i].value==prevVal && i!=sec_col){
-                noChange=1;
-            }
-        }
-        for(i=rowStart;i<=rowEnd;i++){
-            for(j=colStart;j<=colEnd;j++){
-                if(sBoard->board[i][j].value==prevVal && i!=sec_row && j!=sec_col){
-                    noChange=1;
-                }
-            }
+    if(journal->cellCount==journal->cellCapacity){
+        journal->cellCapacity = journal->cellCapacity==0 ? sBoard->length : 2*journal->cellCapacity;
+        journal->cellIndex = (int *) realloc(journal->cellIndex,journal->cellCapacity*sizeof(int));
+        journal->cellPrev = (Cell *) realloc(journal->cellPrev,journal->cellCapacity*sizeof(Cell));
+        if(journal->cellIndex==NULL || journal->cellPrev==NULL){
+            printf("Error: memory allocation has failed in journalCell, Exiting...\n");
+            exit(0);
         }
-        if(noChange!=1)
-            sBoard->board[sec_row][sec_col].errorFlag=0;
     }
+    journal->cellIndex[journal->cellCount] = row*sBoard->length+col;
+    journal->cellPrev[journal->cellCount] = CELL(sBoard,row,col);
+    journal->cellCount++;
 }
-/**  blockClearCleanup:
-* @brief After a clear, update previously erroneous cells to non-erroneous (if any) in the cleared cell's block
+
+/**  journalUnit:
+* @brief Saves a (unit,value) slot's state in the board's journal before it's changed (if the board is marked)
 * @param sudokuBoard *sBoard - a pointer to the board played
-* @param int block- indicates the cell's block in the board (0-based)
-* @param int prevVal - the original value of the cell that is being cleared
+* @param int slot - the slot (see UNIT_SLOT)
 * @return void
 */
-void blockClearCleanup(sudokuBoard *sBoard,int block,int prevVal){
-    int count,sec_row,sec_col,i,j,noChange=0;
-    int ROWS=sBoard->rowsInBlock,COLS=sBoard->colsInBlock;
-    int rowStart,rowEnd,colStart,colEnd;
-    rowStart = (block/ROWS)*ROWS , rowEnd = (((block/ROWS)+1)*ROWS)-1;
-    colStart = (block%ROWS)*COLS , colEnd = (((block%ROWS)+1)*COLS)-1;
-    /*Check Block*/
-    count=0;
-    for(i=rowStart;i<=rowEnd;i++){
-        for(j=colStart;j<=colEnd;j++){
-            if(sBoard->board[i][j].value==prevVal){
-                count++;
-                sec_row=i;sec_col=j;
-            }
-        }
-    }
-    if(count==0){
-        sBoard->invalidBlocks[block][prevVal-1]=0;
+void journalUnit(sudokuBoard *sBoard,int slot){
+    boardJournal *journal = sBoard->journal;
+    unitRecord *record;
+    if(journal==NULL){
+        return;
     }
-    if(count==1){
-        /*NEED TO CHECK ROW AND COL*/
-        for(i=0;i<sBoard->length;i++){
-            if(sBoard->board[sec_row][i].value==prevVal && i!=sec_col)
-                noChange=1;
-        }
-        for(i=0;i<sBoard->length;i++){
-            if(sBoard->board[i][sec_col].value==prevVal && i!=sec_row){
-                noChange=1;
-            }
+    if(journal->unitCount==journal->unitCapacity){
+        journal->unitCapacity = journal->unitCapacity==0 ? sBoard->length : 2*journal->unitCapacity;
+        journal->units = (unitRecord *) realloc(journal->units,journal->unitCapacity*sizeof(unitRecord));
+        if(journal->units==NULL){
+            printf("Error: memory allocation has failed in journalUnit, Exiting...\n");
+            exit(0);
         }
-        if(noChange!=1)
-            sBoard->board[sec_row][sec_col].errorFlag=0;
     }
+    record = &journal->units[journal->unitCount++];
+    record->slot = slot;
+    record->occurrences = sBoard->occurrences[slot];
+    record->holders = sBoard->holders[slot];
+    record->word = *slotWord(sBoard,slot);
+}
+
+/**  slotWord:
+* @brief Finds the bitset word holding a (unit,value) slot's bit
+* @param sudokuBoard *sBoard - a pointer to the board played
+* @param int slot - the slot (see UNIT_SLOT)
+* @return unitSet* - a pointer to the word
+*/
+unitSet *slotWord(sudokuBoard *sBoard,int slot){
+    int unit = slot/sBoard->length;/*units of all three tables are contiguous from invalidRows*/
+    return &sBoard->invalidRows[unit*sBoard->unitWords+(slot%sBoard->length)/UNIT_SET_BITS];
+}
+
+/**  legalWord:
+* @brief Finds a word of the bitset of values that are legal for a cell
+* @param sudokuBoard *sBoard - a pointer to the board played
+* @param int row/col - indicates the cell's location in the board (0-based)
+* @param int w - the index of the word (0..unitWords-1)
+* @return unitSet - the values of the word not set in the cell's row , column or block (bits past the board's length are cleared)
+*/
+unitSet legalWord(sudokuBoard *sBoard,int row,int col,int w){
+    int block,rest;
+    unitSet legal;
+    block = (sBoard->rowsInBlock)*(row/sBoard->rowsInBlock)+(col/sBoard->colsInBlock);
+    legal = ~(sBoard->invalidRows[row*sBoard->unitWords+w] | sBoard->invalidCols[col*sBoard->unitWords+w]
+              | sBoard->invalidBlocks[block*sBoard->unitWords+w]);
+    rest = sBoard->length-w*(int)UNIT_SET_BITS;
+    if(rest<(int)UNIT_SET_BITS)
+        legal &= (1UL<<rest)-1;
+    return legal;
+}
+
+/**  unitPopCount:
+* @brief Counts the set bits of a bitset word
+* @param unitSet word - the word
+* @return int - the number of set bits
+*/
+int unitPopCount(unitSet word){
+#if defined(__GNUC__)
+    return __builtin_popcountl(word);
+#else
+    int count=0;
+    while(word){
+        word &= word-1;
+        count++;
+    }
+    return count;
+#endif
 }
 
 /*Debug Methods*/
@@ -570,7 +625,7 @@ void printInvalids(sudokuBoard *sBoard,char type){
         for(i=0;i<sBoard->length;i++){
             puts("");
             for(j=0;j<sBoard->length;j++){
-                printf("%d ",sBoard->invalidRows[i][j]);
+                printf("%d ",UNIT_HAS(sBoard,invalidRows,i,j));
             }
         }
         puts("");
@@ -580,7 +635,7 @@ void printInvalids(sudokuBoard *sBoard,char type){
         for(i=0;i<sBoard->length;i++){
             puts("");
             for(j=0;j<sBoard->length;j++){
-                printf("%d ",sBoard->invalidCols[i][j]);
+                printf("%d ",UNIT_HAS(sBoard,invalidCols,i,j));
             }
         }
         puts("");
@@ -590,7 +645,7 @@ void printInvalids(sudokuBoard *sBoard,char type){
         for(i=0;i<sBoard->length;i++){
             puts("");
             for(j=0;j<sBoard->length;j++){
-                printf("%d ",sBoard->invalidBlocks[i][j]);
+                printf("%d ",UNIT_HAS(sBoard,invalidBlocks,i,j));
             }
         }
         puts("");
@@ -600,7 +655,7 @@ void printInvalids(sudokuBoard *sBoard,char type){
         for(i=0;i<sBoard->length;i++){
             puts("");
             for(j=0;j<sBoard->length;j++){
-                printf("%d ",sBoard->board[i][j].errorFlag);
+                printf("%d ",CELL(sBoard,i,j).errorFlag);
             }
         }
         puts("");
@@ -610,7 +665,7 @@ void printInvalids(sudokuBoard *sBoard,char type){
         for(i=0;i<sBoard->length;i++){
             puts("");
             for(j=0;j<sBoard->length;j++){
-                printf("%d ",sBoard->board[i][j].userMod);
+                printf("%d ",CELL(sBoard,i,j).userMod);
             }
         }
         puts("");
@@ -1,5 +1,7 @@
 #ifndef SUDOKUBOARD_H_INCLUDED
 #define SUDOKUBOARD_H_INCLUDED
+#include <stddef.h>
+#include "rng.h"
 
 
 /* A helping structure to represent a row/column location of a cell in a sudoko board */
@@ -10,37 +12,113 @@ typedef struct index_pair{
     int y;
 }Index_Pair;
 
+/* Largest board side a cell's value can hold */
+#define CELL_MAX_VALUE 255
+
 /* A structure to represent a cell of a sudoku board */
-/* Member: int value - the cell's value (ranges from 1-N , and 0 is empty)*/
-/* Member: int fixed - indicator if the cell is fixed (can't be changed by user) */
-/* Member: int errorFlag - indicator if the cell is erroneous */
-/* Member: int userMod - indicator if the cell is user-modified (non-empty, non-fixed cells) */
+/* Member: unsigned char value - the cell's value (ranges from 1-N , and 0 is empty)*/
+/* Member: unsigned int fixed - indicator if the cell is fixed (can't be changed by user) */
+/* Member: unsigned int errorFlag - indicator if the cell is erroneous */
+/* Member: unsigned int userMod - indicator if the cell is user-modified (non-empty, non-fixed cells) */
+/* Member: unsigned int conflicts - number of the cell's units (row/column/block) holding its value more than once (0-3) */
 typedef struct cell{
-    int value;
-    int fixed;
-    int errorFlag;
-    int userMod;
+    unsigned char value;
+    unsigned int fixed:1;
+    unsigned int errorFlag:1;
+    unsigned int userMod:1;
+    unsigned int conflicts:2;
 }Cell;
 
+/* A word of a value bitset; a unit (row/column/block) keeps one bit for each value in unitWords words */
+typedef unsigned long unitSet;
+#define UNIT_SET_BITS (sizeof(unitSet)*8)
+
+/* A structure to represent running counts over a board's cells , kept up to date on every change */
+/* Member: int emptyCells - number of cells without a value */
+/* Member: int errorCells - number of erroneous cells */
+/* Member: int fixedErrorCells - number of erroneous fixed cells */
+/* Member: unsigned long version - stamp of the board's cell values , renewed on every change and unique across all boards */
+typedef struct board_counts{
+    int emptyCells;
+    int errorCells;
+    int fixedErrorCells;
+    unsigned long version;
+}boardCounts;
+
+/* A structure to represent the saved state of a (unit,value) slot of a board (see UNIT_SLOT) */
+/* Member: int slot - the slot's index */
+/* Member: unsigned char occurrences - the slot's occurrence count */
+/* Member: unsigned short holders - the slot's XOR of holder cells */
+/* Member: unitSet word - the bitset word holding the slot's bit */
+typedef struct unit_record{
+    int slot;
+    unsigned char occurrences;
+    unsigned short holders;
+    unitSet word;
+}unitRecord;
+
+/* A structure to represent the changes made to a board since it was marked (see markBoard) */
+/* Member: int* cellIndex / Cell* cellPrev - the journaled cells (row*N+col) and their contents before the change */
+/* Member: int cellCount / cellCapacity - number of journaled cells and room allocated for them */
+/* Member: unitRecord* units - the journaled (unit,value) slots , with their state before the change */
+/* Member: int unitCount / unitCapacity - number of journaled slots and room allocated for them */
+/* Member: boardCounts markCounts - the board's counts when it was marked */
+typedef struct board_journal{
+    int* cellIndex;
+    Cell* cellPrev;
+    int cellCount;
+    int cellCapacity;
+    unitRecord* units;
+    int unitCount;
+    int unitCapacity;
+    boardCounts markCounts;
+}boardJournal;
+
 /* A structure to represent a sudoku board */
-/* Member: Cell** board - a 2D array of cells the represents the game board */
+/* All counts , cells , value bitsets and occurrence tables live in one allocation (image) so the board can be walked and copied as a block */
+/* Rows , columns and blocks are units 0..N-1 of tables 0 , 1 and 2 ; every (table,unit,value) has a slot (see UNIT_SLOT) */
+/* Member: boardCounts* counts - running counts of empty and erroneous cells */
+/* Member: Cell* cells - the game board's cells in row-major order (access with CELL) */
 /* Member: int rowsInBlock - row subgrid (block) size */
 /* Member: int colsInBlock - column subgrid (block) size */
 /* Member: int length - size of the board's sides */
-/* Member: int** invalidRows - a 2D boolean array that represents which values are already set in a board's row */
-/* Member: int** invalidCols - a 2D boolean array that represents which values are already set in a board's column */
-/* Member: int** invalidBlocks - a 2D boolean array that represents which values are already set in a board's block */
+/* Member: int unitWords - number of unitSet words in a unit's bitset */
+/* Member: unitSet* invalidRows - for every row , a bitset of the values already set in it (access with UNIT_HAS/UNIT_ADD/UNIT_REMOVE) */
+/* Member: unitSet* invalidCols - for every column , a bitset of the values already set in it */
+/* Member: unitSet* invalidBlocks - for every block , a bitset of the values already set in it */
+/* Member: unsigned char* occurrences - for every slot , how many cells of the unit hold the value */
+/* Member: unsigned short* holders - for every slot , the XOR of the indices (row*N+col) of the cells holding it , so a lone holder is known without a scan */
+/* Member: void* image - the single allocation holding the counts , the bitsets , the cells , the holders and the occurrences , in that order */
+/* Member: size_t imageSize - size of image in bytes */
+/* Member: boardJournal* journal - changes made by setCell/setCellFixed since the board was marked , NULL if it isn't marked */
 typedef struct sudoku_board{
     /*solvedFlag and errorFlag deleted*/
-    Cell** board;
+    boardCounts* counts;
+    Cell* cells;
     int rowsInBlock;
     int colsInBlock;
     int length;
-    int** invalidRows;
-    int** invalidCols;
-    int** invalidBlocks;
+    int unitWords;
+    unitSet* invalidRows;
+    unitSet* invalidCols;
+    unitSet* invalidBlocks;
+    unsigned char* occurrences;
+    unsigned short* holders;
+    void* image;
+    size_t imageSize;
+    boardJournal* journal;
 }sudokuBoard;
 
+/* Accessors - the cell at row/col of a board (an lvalue) */
+#define CELL(sBoard,row,col) ((sBoard)->cells[(row)*(sBoard)->length+(col)])
+/* Accessors - test/add/remove a value (0-based) in the bitset of a unit , table is invalidRows/invalidCols/invalidBlocks */
+#define UNIT_WORD(sBoard,table,unit,val) ((sBoard)->table[(unit)*(sBoard)->unitWords+(val)/UNIT_SET_BITS])
+#define UNIT_HAS(sBoard,table,unit,val) ((int)((UNIT_WORD(sBoard,table,unit,val)>>((val)%UNIT_SET_BITS))&1UL))
+#define UNIT_ADD(sBoard,table,unit,val) (UNIT_WORD(sBoard,table,unit,val) |= (1UL<<((val)%UNIT_SET_BITS)))
+#define UNIT_REMOVE(sBoard,table,unit,val) (UNIT_WORD(sBoard,table,unit,val) &= ~(1UL<<((val)%UNIT_SET_BITS)))
+/* Accessors - the slot of a value (0-based) in a unit of table 0 (rows) , 1 (columns) or 2 (blocks) */
+#define UNIT_SLOT(sBoard,tableIndex,unit,val) (((tableIndex)*(sBoard)->length+(unit))*(sBoard)->length+(val))
+
 
 /*Public functions declarations*/
 
@@ -51,10 +129,16 @@ int isLegalValue(sudokuBoard *sBoard,int row,int col,int val);
 int isBoardError(sudokuBoard *sBoard);
 int isFixedCellsLegal(sudokuBoard *sBoard);
 int countEmptyCells(sudokuBoard *sBoard);
+unsigned long boardVersion(sudokuBoard *sBoard);
 void clearAllFixedCells(sudokuBoard *sBoard);
+void setCellFixed(sudokuBoard *sBoard,int row,int col,int fixed);
 void copy_boards(sudokuBoard *oldBoard , sudokuBoard *newBoard);
+sudokuBoard *cloneBoard(sudokuBoard *sBoard);
+void markBoard(sudokuBoard *sBoard);
+void rollbackBoard(sudokuBoard *sBoard);
+void unmarkBoard(sudokuBoard *sBoard);
 Index_Pair find_empty_cell(sudokuBoard *sBoard);
-int randomizeLegalValue(sudokuBoard *sBoard,int row,int col);
+int randomizeLegalValue(sudokuBoard *sBoard,int row,int col,rngState *rng);
 int setCell(sudokuBoard *sBoard,int row,int col,int value);
 
 
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "SudokuGame.h"
+#include "solver.h"
 
 /*Private functions declarations*/
 void undoCommands(sudokuGame *game, int printMessage);
@@ -20,8 +21,13 @@ void initNewGame(sudokuGame *sGame) {
     }
     sGame->currBoard = NULL;
     sGame -> currSol = NULL;
+    sGame->solVersion = 0;
+    sGame->noSolVersion = 0;
+    sGame->solverState = NULL;
     initMoveList(sGame->currentMove);
     sGame->markErrors = 1;
+    sGame->solverLog = 0;
+    rngSeed(&sGame->rng, 0);
 }
 
 /**  setMarkErrors:
@@ -34,6 +40,26 @@ void setMarkErrors(sudokuGame *game, int x) {
     game->markErrors = x;
 }
 
+/**  setSolverLog:
+* @brief Sets the game's solverLog indicator on/off
+* @param sudokuGame* game - a pointer to the current sudoku game
+* @param int x - updates the solverLog member of game to x
+* @return void
+*/
+void setSolverLog(sudokuGame *game, int x) {
+    game->solverLog = x;
+}
+
+/**  setSeed:
+* @brief Restarts the game's random generator from a seed - equal seeds give equal sequences of random choices
+* @param sudokuGame* game - a pointer to the current sudoku game
+* @param unsigned long seed - the seed
+* @return void
+*/
+void setSeed(sudokuGame *game, unsigned long seed) {
+    rngSeed(&game->rng, seed);
+}
+
 /**  printGameBoard:
 * @brief Prints the current board of a sudoku game depending on mode and mark errors value
 * @param sudokuGame* game - a pointer to the current sudoku game
@@ -75,7 +101,7 @@ int gameSetCell(sudokuGame *sudokuGame, int row, int col, int val, int isMultiSe
     Command *command;
     CommandNode *commandNode;
 
-    prevVal = sudokuGame->currBoard->board[row][col].value;
+    prevVal = CELL(sudokuGame->currBoard,row,col).value;
 
     didSet = setCell(sudokuGame->currBoard, row, col, val);
 
@@ -169,6 +195,7 @@ void undoAllMoves(sudokuGame *game) {
 * @return void
 */
 void freeSudokuGame(sudokuGame *game) {
+    releaseSolvers(game);
     freeSolution(game);
     freeBoard(game->currBoard);
     clearAllMoves(game->currentMove);
@@ -200,6 +227,8 @@ void get_empty_solution(sudokuGame *sGame) {
             sGame->currSol[i][j] = 0;
         }
     }
+    sGame->solVersion = 0;
+    sGame->noSolVersion = 0;
     return;
 }
 
@@ -14,18 +14,30 @@ typedef enum gameMode {
 /* Member: MoveNode* currentMove - a pointer to the current move performed in the game*/
 /* Member: sudokuBoard* currBoard - represents the current sudoku board that the user is playing with*/
 /* Member: int** currSol - represents the current solution of the board, if necessary*/
+/* Member: unsigned long solVersion - the board version currSol is a solution of (0 if none)*/
+/* Member: unsigned long noSolVersion - the last board version found unsolvable (0 if none)*/
 /* Member: int markErrors - 1 if user wants to print errors, 0 otherwise*/
+/* Member: int solverLog - 1 if the LP solver should write its log and model files, 0 otherwise*/
+/* Member: rngState rng - the game's random generator - every random choice of the game is drawn from it (see the seed command)*/
+/* Member: void* solverState - what the LP solver keeps for the whole session: its environment and live model (NULL until first used)*/
 typedef struct sudoku_game {
     MODE mode;
     MoveNode *currentMove;
     sudokuBoard *currBoard;
     int **currSol;
+    unsigned long solVersion;
+    unsigned long noSolVersion;
     int markErrors;
+    int solverLog;
+    rngState rng;
+    void *solverState;
 } sudokuGame;
 
 /*Public functions declarations*/
 void initNewGame(sudokuGame *game);
 void setMarkErrors(sudokuGame *game, int x);
+void setSolverLog(sudokuGame *game, int x);
+void setSeed(sudokuGame *game, unsigned long seed);
 void printGameBoard(sudokuGame *game);
 void clearAllGameMoves(sudokuGame *game);
 int gameSetCell(sudokuGame *sudokuGame, int row, int col, int val, int isMultiSet);
@@ -0,0 +1,696 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "bitSolver.h"
+
+/* Values the shortest run of a restarting search may place , per cell of the board (see restartSearch) */
+#define BIT_RESTART_UNIT 32
+
+#if defined(__GNUC__)
+#define BIT_POPCOUNT(x) __builtin_popcountl(x)
+#else
+#define BIT_POPCOUNT(x) bitPopCount(x)
+#endif
+
+/*Private functions declarations*/
+int bitPopCount(bitMask mask);
+bitMask bitCandidates(bitEnv *env,int cell);
+void toggleValue(bitEnv *env,int cell,bitMask bit);
+void changeCandidate(bitEnv *env,int cell,bitMask bit,int mod);
+void initPeers(bitEnv *env,int ROWS,int COLS);
+int nextCell(bitEnv *env,int depth,BitFrame *frame,int unitBranching);
+bitMask unitPlaces(bitEnv *env,int *unit,bitMask *places);
+int moveToDepth(bitEnv *env,int depth,int cell);
+solCount searchSolutions(bitEnv *env,solCount limit,int **solution,unsigned long cutoff);
+int restartSearch(bitEnv *env,int **solution);
+void withdrawSearch(bitEnv *env);
+void reapplySearch(bitEnv *env);
+unsigned long lubyTerm(unsigned long i);
+unsigned long budgetSlice(bitEnv *env,unsigned long cutoff,unsigned long *spent);
+void recordBitSolution(bitEnv *env,int **solution,bitMask lastBit);
+int bitValue(bitMask bit);
+bitMask randomBit(bitEnv *env,bitMask mask);
+
+
+/**  bitEnvInit:
+* @brief Builds the bitmask search state of a sudoku board
+* @param bitEnv *env - a pointer to the environment to initialize
+* @param sudokuBoard *sBoard - a pointer to the board being solved
+* @param CELL_ORDER order - the order in which empty cells will be solved
+* @return int - 1 if the set cells of the board don't conflict , 0 o\w
+*/
+int bitEnvInit(bitEnv *env,sudokuBoard *sBoard,CELL_ORDER order){
+    int i,j,N,cell,block,value,consistent=1;
+    int ROWS=sBoard->rowsInBlock,COLS=sBoard->colsInBlock;
+    bitMask bit;
+    N = sBoard->length;
+    env->length = N;
+    env->order = order;
+    env->peers = NULL;
+    env->candCount = NULL;
+    env->unitCells = NULL;
+    env->cellBits = NULL;
+    env->randomOrder = 0;
+    env->rng = NULL;
+    env->resumeDepth = -1;
+    env->budget = 0;
+    env->full = (N==BIT_MAX_LENGTH) ? ~(bitMask)0 : (((bitMask)1<<N)-1);
+    env->rows = (bitMask*)calloc(N,sizeof(bitMask));
+    env->cols = (bitMask*)calloc(N,sizeof(bitMask));
+    env->blocks = (bitMask*)calloc(N,sizeof(bitMask));
+    env->cellRow = (int*)malloc(N*N*sizeof(int));
+    env->cellCol = (int*)malloc(N*N*sizeof(int));
+    env->cellBlock = (int*)malloc(N*N*sizeof(int));
+    env->empties = (int*)malloc(N*N*sizeof(int));
+    env->frames = (BitFrame*)malloc(N*N*sizeof(BitFrame));
+    if(!env->rows || !env->cols || !env->blocks || !env->cellRow || !env->cellCol || !env->cellBlock || !env->empties || !env->frames){
+        printf("Error: memory allocation has failed in bitEnvInit, Exiting...\n");
+        exit(0);
+    }
+    env->emptyCount = 0;
+    for(i=0;i<N;i++){
+        for(j=0;j<N;j++){
+            cell = i*N+j;
+            block = ROWS*(i/ROWS)+(j/COLS);
+            env->cellRow[cell] = i;
+            env->cellCol[cell] = j;
+            env->cellBlock[cell] = block;
+            if(CELL(sBoard,i,j).value==0){
+                env->empties[env->emptyCount++] = cell;
+                continue;
+            }
+            bit = (bitMask)1<<(CELL(sBoard,i,j).value-1);
+            if((env->rows[i]|env->cols[j]|env->blocks[block])&bit)
+                consistent = 0;
+            env->rows[i] |= bit;
+            env->cols[j] |= bit;
+            env->blocks[block] |= bit;
+        }
+    }
+    if(order==mostConstrained){
+        initPeers(env,ROWS,COLS);
+        env->candCount = (int*)malloc(N*N*sizeof(int));
+        env->cellBits = (bitMask*)malloc(N*N*sizeof(bitMask));
+        if(!env->candCount || !env->cellBits){
+            printf("Error: memory allocation has failed in bitEnvInit, Exiting...\n");
+            exit(0);
+        }
+        for(cell=0;cell<N*N;cell++){
+            env->candCount[cell] = BIT_POPCOUNT(bitCandidates(env,cell));
+            value = CELL(sBoard,env->cellRow[cell],env->cellCol[cell]).value;
+            env->cellBits[cell] = value==0 ? 0 : (bitMask)1<<(value-1);
+        }
+    }
+    return consistent;
+}
+
+/**  bitEnvFree:
+* @brief Frees all memory used by a bitmask search environment
+* @param bitEnv *env - a pointer to the environment to free
+* @return void
+*/
+void bitEnvFree(bitEnv *env){
+    free(env->rows);
+    free(env->cols);
+    free(env->blocks);
+    free(env->cellRow);
+    free(env->cellCol);
+    free(env->cellBlock);
+    free(env->empties);
+    free(env->frames);
+    free(env->peers);
+    free(env->candCount);
+    free(env->unitCells);
+    free(env->cellBits);
+}
+
+/**  bitCountSolutions:
+* @brief Counts the solutions of the board by exhaustive backtracking over candidate bitmasks
+* @param bitEnv *env - a pointer to an initialized environment
+* @param solCount limit - stop searching once this many solutions were found (0 for no limit)
+* @return solCount - the number of different valid solutions to the board (at most limit , or SOL_COUNT_MAX if the count saturated)
+*/
+solCount bitCountSolutions(bitEnv *env,solCount limit){
+    return searchSolutions(env,limit,NULL,0);
+}
+
+/**  bitSolve:
+* @brief Finds a solution of the board. In mostConstrained order the search propagates first: cells left with
+*        a single candidate , and values left with a single place in a row , column or block , are filled before
+*        any branching , and a cell or value left with no option fails the branch at once. A search that runs long
+*        takes turns with random probes (see restartSearch)
+* @param bitEnv *env - a pointer to an initialized environment (probes draw from its rng , or from a private
+*        generator if it has none)
+* @param int **solution - a 2D array to get the values of the empty cells (other entries are left as they are)
+* @return int - 1 if the board was solved , 0 if it has no solution , -1 if the environment's budget ran out first
+*/
+int bitSolve(bitEnv *env,int **solution){
+    return restartSearch(env,solution);
+}
+
+/**  bitSample:
+* @brief Finds a random solution of the board - the search tries every cell's candidates in random order ,
+*        so repeated calls sample the board's solutions (not uniformly , but every solution can come up).
+*        Like bitSolve it restarts with random probes (see restartSearch) , so an unlucky order can't stall it
+* @param bitEnv *env - a pointer to an initialized environment with its rng set (left as it was , the generator is advanced)
+* @param int **solution - a 2D array to get the values of the empty cells (other entries are left as they are)
+* @return int - 1 if a solution was found , 0 if the board has no solution , -1 if the environment's budget ran out first
+*/
+int bitSample(bitEnv *env,int **solution){
+    int found;
+    env->randomOrder = 1;
+    found = restartSearch(env,solution);
+    env->randomOrder = 0;
+    return found;
+}
+
+/**  bitSinglesLeft:
+* @brief Fills cells left with a single candidate (or holding the only place of a value in one of their units) ,
+*        one at a time , until no such cell is left
+* @param bitEnv *env - a pointer to an environment initialized in mostConstrained order (left as it was)
+* @return int - number of cells still unsolved when single candidates run out
+*/
+int bitSinglesLeft(bitEnv *env){
+    int cell,filled=0,left;
+    bitMask candidates;
+    while((cell=bitChooseCell(env,&candidates))!=-1 && BIT_POPCOUNT(candidates)==1){
+        bitAssign(env,cell,candidates);
+        env->frames[filled].cell = cell;/*The search stack is idle - keep the fills there*/
+        env->frames[filled].placed = candidates;
+        filled++;
+    }
+    left = env->emptyCount;
+    while(filled>0){
+        filled--;
+        bitUnassign(env,env->frames[filled].cell,env->frames[filled].placed);
+    }
+    return left;
+}
+
+/**  restartSearch:
+* @brief Looks for a solution in slices: the search runs until its cutoff and is suspended , then a probe - a fresh search
+*        in random order - gets as long before it's withdrawn , and so on. An unlucky early choice of the search then
+*        can't stall it for long , as some probe makes other choices , while the search itself is never thrown away ,
+*        so a board without solutions costs at most twice a single search. Cutoffs follow the Luby sequence
+* @param bitEnv *env - a pointer to an initialized environment (probes draw from its rng , or from a private generator
+*        if it has none). If its budget is set , slices stop once that many values were placed in all
+* @param int **solution - a 2D array to get the values of the empty cells (other entries are left as they are)
+* @return int - 1 if a solution was found , 0 if the board has no solution , -1 if the budget ran out first
+*/
+int restartSearch(bitEnv *env,int **solution){
+    rngState own,*shared=env->rng;
+    BitFrame *frames=env->frames,*probeFrames;
+    unsigned long unit = BIT_RESTART_UNIT*(unsigned long)env->length*env->length,run=1,spent=0;
+    int found,settled,depth,randomOrder=env->randomOrder;
+    found = searchSolutions(env,1,solution,budgetSlice(env,unit,&spent))>0;
+    if(env->resumeDepth==-1)
+        return found;
+    probeFrames = (BitFrame*)malloc(env->emptyCount*sizeof(BitFrame));
+    if(probeFrames==NULL){
+        printf("Error: memory allocation has failed in restartSearch, Exiting...\n");
+        exit(0);
+    }
+    if(shared==NULL){
+        rngSeed(&own,(unsigned long)env->emptyCount);
+        env->rng = &own;
+    }
+    while(env->resumeDepth!=-1){/*The search is suspended - set its values aside and run a probe*/
+        depth = env->resumeDepth;
+        withdrawSearch(env);
+        env->resumeDepth = -1;
+        if(env->budget!=0 && spent==env->budget){/*Give up , leaving the board as it was*/
+            found = -1;
+            break;
+        }
+        env->frames = probeFrames;
+        env->randomOrder = 1;
+        found = searchSolutions(env,1,solution,budgetSlice(env,unit*lubyTerm(run),&spent))>0;
+        settled = env->resumeDepth==-1;/*The probe found a solution , or ran out of candidates - the board has none*/
+        if(!settled)
+            withdrawSearch(env);
+        env->frames = frames;
+        env->randomOrder = randomOrder;
+        env->resumeDepth = -1;
+        if(settled)
+            break;
+        if(env->budget!=0 && spent==env->budget){
+            found = -1;
+            break;
+        }
+        env->resumeDepth = depth;
+        reapplySearch(env);
+        found = searchSolutions(env,1,solution,budgetSlice(env,unit*lubyTerm(run),&spent))>0;
+        run++;
+    }
+    env->rng = shared;
+    free(probeFrames);
+    return found;
+}
+
+/**  budgetSlice:
+* @brief Cuts a slice of a restarting search down to what's left of the environment's budget , and books it as spent
+* @param bitEnv *env - a pointer to an initialized environment (see budget)
+* @param unsigned long cutoff - the slice's full cutoff
+* @param unsigned long *spent - values booked so far , gets the slice added (less than the budget on entry)
+* @return unsigned long - the cutoff to run the slice with
+*/
+unsigned long budgetSlice(bitEnv *env,unsigned long cutoff,unsigned long *spent){
+    if(env->budget!=0 && env->budget-*spent<cutoff)
+        cutoff = env->budget-*spent;
+    *spent += cutoff;
+    return cutoff;
+}
+
+/**  searchSolutions:
+* @brief Backtracks over candidate bitmasks , counting solutions and recording the first one
+* @param bitEnv *env - a pointer to an initialized environment. If its resumeDepth is set , a suspended search is carried on
+* @param solCount limit - stop searching once this many solutions were found (0 for no limit)
+* @param int **solution - a 2D array to get the values of the empty cells in the first solution found (can be NULL)
+* @param unsigned long cutoff - suspend the search after placing this many values (0 for no cutoff) - its values stay
+*        placed and resumeDepth is set , until it's carried on or withdrawn (see withdrawSearch). Solutions found before
+*        a cutoff aren't carried over , so it's meant for searches with a limit of 1
+* @return solCount - the number of different valid solutions to the board (at most limit , or SOL_COUNT_MAX if the count saturated)
+*/
+solCount searchSolutions(bitEnv *env,solCount limit,int **solution,unsigned long cutoff){
+    int depth,last,leaves;
+    unsigned long placed=0;
+    solCount count=0;
+    bitMask bit;
+    BitFrame *frame;
+    if(env->emptyCount==0)
+        return 1;/*Solved*/
+    if(limit==0)/*No limit - stop only if the counter would overflow*/
+        limit = SOL_COUNT_MAX;
+    last = env->emptyCount-1;
+    depth = env->resumeDepth;
+    env->resumeDepth = -1;
+    if(depth==-1){
+        depth = 0;
+        frame = env->frames;
+        frame->cell = nextCell(env,0,frame,1);
+        frame->placed = 0;
+    }
+    while(depth>=0){
+        frame = &env->frames[depth];
+        if(frame->placed){/*Backtracked into this frame - undo its last value*/
+            toggleValue(env,frame->cell,frame->placed);
+            frame->placed = 0;
+        }
+        if(frame->remaining==0){
+            depth--;
+            continue;
+        }
+        if(depth==last){/*Every candidate of the last empty cell completes a solution*/
+            leaves = BIT_POPCOUNT(frame->remaining);
+            if(count==0 && solution!=NULL)
+                recordBitSolution(env,solution,env->randomOrder ? randomBit(env,frame->remaining) : frame->remaining & (~frame->remaining+1));
+            frame->remaining = 0;
+            if(limit-count<=(solCount)leaves)
+                break;
+            count += leaves;
+            depth--;
+            continue;
+        }
+        if(cutoff!=0 && placed++==cutoff){
+            env->resumeDepth = depth;
+            return 0;
+        }
+        bit = env->randomOrder ? randomBit(env,frame->remaining) : frame->remaining & (~frame->remaining+1);/*lowest candidate , or a random one when sampling*/
+        frame->remaining ^= bit;
+        if(frame->unit!=-1){/*The picked bit is a place of the frame's value in its unit*/
+            frame->cell = moveToDepth(env,depth,env->unitCells[frame->unit*env->length+bitValue(bit)-1]);
+            bit = frame->value;
+        }
+        toggleValue(env,frame->cell,bit);
+        frame->placed = bit;
+        depth++;
+        frame = &env->frames[depth];
+        frame->cell = nextCell(env,depth,frame,1);
+        frame->placed = 0;
+    }
+    if(depth>=0){/*Stopped at the limit - withdraw the values still placed*/
+        count = limit;
+        for(;depth>=0;depth--){
+            if(env->frames[depth].placed)
+                toggleValue(env,env->frames[depth].cell,env->frames[depth].placed);
+        }
+    }
+    return count;
+}
+
+/**  withdrawSearch:
+* @brief Takes the values of a suspended search off the board , leaving its frames for reapplySearch
+* @param bitEnv *env - a pointer to an environment with a suspended search (see searchSolutions)
+* @return void
+*/
+void withdrawSearch(bitEnv *env){
+    int depth;
+    for(depth=env->resumeDepth;depth>=0;depth--){
+        if(env->frames[depth].placed)
+            toggleValue(env,env->frames[depth].cell,env->frames[depth].placed);
+    }
+}
+
+/**  reapplySearch:
+* @brief Puts the values of a withdrawn search back , so it can be carried on
+* @param bitEnv *env - a pointer to an environment with a withdrawn search (its frames and resumeDepth as they were)
+* @return void
+*/
+void reapplySearch(bitEnv *env){
+    int depth;
+    for(depth=0;depth<=env->resumeDepth;depth++){
+        moveToDepth(env,depth,env->frames[depth].cell);
+        if(env->frames[depth].placed)
+            toggleValue(env,env->frames[depth].cell,env->frames[depth].placed);
+    }
+}
+
+/**  bitChooseCell:
+* @brief Picks the unsolved cell the search would branch on next
+* @param bitEnv *env - a pointer to an initialized environment
+* @param bitMask *candidates - gets the values the search would try in the chosen cell (0 if the board is a dead end)
+* @return int - the chosen cell's index (row*N+col) , or -1 if no cell is left to solve
+*/
+int bitChooseCell(bitEnv *env,bitMask *candidates){
+    int cell;
+    BitFrame frame;
+    if(env->emptyCount==0)
+        return -1;
+    cell = nextCell(env,0,&frame,0);
+    *candidates = frame.remaining;
+    return cell;
+}
+
+/**  bitAssign:
+* @brief Sets a value in an unsolved cell and removes the cell from the cells left to solve
+* @param bitEnv *env - a pointer to an initialized environment
+* @param int cell - the cell's index (row*N+col)
+* @param bitMask bit - the value's bit (must be a candidate of the cell)
+* @return void
+*/
+void bitAssign(bitEnv *env,int cell,bitMask bit){
+    int i;
+    for(i=0;i<env->emptyCount;i++){
+        if(env->empties[i]==cell){
+            env->empties[i] = env->empties[env->emptyCount-1];
+            env->empties[env->emptyCount-1] = cell;
+            env->emptyCount--;
+            break;
+        }
+    }
+    toggleValue(env,cell,bit);
+}
+
+/**  bitUnassign:
+* @brief Undoes a bitAssign - assignments can be undone in any order , as the cells left to solve are kept as an
+*        unordered set (the search undoes its own in reverse order , but callers like genPuzzle take clues out at random)
+* @param bitEnv *env - a pointer to an initialized environment
+* @param int cell - the cell's index (row*N+col) , holding the value set by bitAssign
+* @param bitMask bit - the value's bit
+* @return void
+*/
+void bitUnassign(bitEnv *env,int cell,bitMask bit){
+    toggleValue(env,cell,bit);
+    env->empties[env->emptyCount++] = cell;
+}
+
+/**  bitCandidates:
+* @brief Computes the values that can still be placed in a cell
+* @param bitEnv *env - a pointer to the search environment
+* @param int cell - the cell's index (row*N+col)
+* @return bitMask - the cell's candidate values
+*/
+bitMask bitCandidates(bitEnv *env,int cell){
+    return env->full & ~(env->rows[env->cellRow[cell]] | env->cols[env->cellCol[cell]] | env->blocks[env->cellBlock[cell]]);
+}
+
+/**  toggleValue:
+* @brief Places a value in a cell or removes it, by flipping its bit in the cell's units
+* @param bitEnv *env - a pointer to the search environment
+* @param int cell - the cell's index (row*N+col)
+* @param bitMask bit - the value's bit
+* @return void
+*/
+void toggleValue(bitEnv *env,int cell,bitMask bit){
+    int placing;
+    if(env->order==mostConstrained){
+        placing = (env->rows[env->cellRow[cell]]&bit)==0;
+        if(placing){/*Peers lose the candidate before the cell's units are updated*/
+            changeCandidate(env,cell,bit,-1);
+        }
+        env->cellBits[cell] = placing ? bit : 0;
+        env->rows[env->cellRow[cell]] ^= bit;
+        env->cols[env->cellCol[cell]] ^= bit;
+        env->blocks[env->cellBlock[cell]] ^= bit;
+        if(!placing){/*Peers regain the candidate after the cell's units are updated*/
+            changeCandidate(env,cell,bit,1);
+        }
+        return;
+    }
+    env->rows[env->cellRow[cell]] ^= bit;
+    env->cols[env->cellCol[cell]] ^= bit;
+    env->blocks[env->cellBlock[cell]] ^= bit;
+}
+
+/**  changeCandidate:
+* @brief Updates the candidate counts of a cell's peers for which a value is (or becomes) a candidate
+* @param bitEnv *env - a pointer to the search environment
+* @param int cell - the cell's index (row*N+col)
+* @param bitMask bit - the value's bit
+* @param int mod - the change to the counts (-1 when placing the value , 1 when removing it)
+* @return void
+*/
+void changeCandidate(bitEnv *env,int cell,bitMask bit,int mod){
+    int i,peer,*peers;
+    peers = env->peers + cell*env->peerCount;
+    for(i=0;i<env->peerCount;i++){
+        peer = peers[i];
+        if(((env->rows[env->cellRow[peer]]|env->cols[env->cellCol[peer]]|env->blocks[env->cellBlock[peer]])&bit)==0){
+            env->candCount[peer] += mod;
+        }
+    }
+}
+
+/**  initPeers:
+* @brief Builds the peer list of every cell - all cells sharing a row, column or block with it - and the cell list of every unit
+* @param bitEnv *env - a pointer to the search environment
+* @param int ROWS/COLS - the board's block dimensions
+* @return void
+*/
+void initPeers(bitEnv *env,int ROWS,int COLS){
+    int cell,i,j,row,col,rowStart,colStart,count,N=env->length;
+    env->peerCount = 2*(N-1) + (N-ROWS-COLS+1);
+    env->peers = (int*)malloc(N*N*env->peerCount*sizeof(int));
+    env->unitCells = (int*)malloc(3*N*N*sizeof(int));
+    if(!env->peers || !env->unitCells){
+        printf("Error: memory allocation has failed in initPeers, Exiting...\n");
+        exit(0);
+    }
+    for(cell=0;cell<N*N;cell++){
+        row = env->cellRow[cell], col = env->cellCol[cell];
+        rowStart = (row/ROWS)*ROWS, colStart = (col/COLS)*COLS;
+        env->unitCells[row*N+col] = cell;
+        env->unitCells[(N+col)*N+row] = cell;
+        env->unitCells[(2*N+env->cellBlock[cell])*N+(row-rowStart)*COLS+(col-colStart)] = cell;
+        count = cell*env->peerCount;
+        for(i=0;i<N;i++){
+            if(i!=col)
+                env->peers[count++] = row*N+i;
+            if(i!=row)
+                env->peers[count++] = i*N+col;
+        }
+        for(i=rowStart;i<rowStart+ROWS;i++){
+            for(j=colStart;j<colStart+COLS;j++){
+                if(i!=row && j!=col)
+                    env->peers[count++] = i*N+j;
+            }
+        }
+    }
+}
+
+/**  nextCell:
+* @brief Picks the next cell to solve , moves it to position depth of the empties array and sets up its search frame.
+*        In mostConstrained order that is a cell with the fewest candidates , unless a unit has a value with a single
+*        place left (or none at all) - or , when unit branching is allowed , with fewer places than any cell has candidates
+* @param bitEnv *env - a pointer to the search environment
+* @param int depth - current depth of the search; empties from depth onwards are unsolved
+* @param BitFrame *frame - gets the values to try in the chosen cell , or the unit and value to try the places of
+* @param int unitBranching - 1 to allow branching over the places of a value , 0 to always branch over a cell's candidates
+* @return int - the chosen cell's index (row*N+col)
+*/
+int nextCell(bitEnv *env,int depth,BitFrame *frame,int unitBranching){
+    int i,best,bestCount,count,unit;
+    bitMask value,places;
+    frame->unit = -1;
+    if(env->order==rowMajor){
+        frame->remaining = bitCandidates(env,env->empties[depth]);
+        return env->empties[depth];
+    }
+    best = depth;
+    bestCount = env->candCount[env->empties[depth]];
+    for(i=depth+1;i<env->emptyCount && bestCount>1;i++){
+        count = env->candCount[env->empties[i]];
+        if(count<bestCount){
+            best = i;
+            bestCount = count;
+        }
+    }
+    frame->remaining = bitCandidates(env,env->empties[best]);
+    if(bestCount>1 && (value=unitPlaces(env,&unit,&places))!=0){
+        if(places==0){/*Dead end*/
+            frame->remaining = 0;
+        }
+        else if((places&(places-1))==0){/*The value's only place*/
+            frame->remaining = value;
+            return moveToDepth(env,depth,env->unitCells[unit*env->length+bitValue(places)-1]);
+        }
+        else if(unitBranching && bestCount>2){
+            frame->unit = unit;
+            frame->value = value;
+            frame->remaining = places;
+        }
+    }
+    return moveToDepth(env,depth,env->empties[best]);
+}
+
+/**  unitPlaces:
+* @brief Looks for a row , column or block with a missing value that has at most two places left among its unsolved cells
+* @param bitEnv *env - a pointer to the search environment (in mostConstrained order)
+* @param int *unit - gets the unit's index (rows first , then columns , then blocks)
+* @param bitMask *places - gets the value's places (bit i for the unit's i-th cell) , 0 if it has none
+* @return bitMask - the value's bit (one with no place or a single place is preferred) , 0 if there is no such value
+*/
+bitMask unitPlaces(bitEnv *env,int *unit,bitMask *places){
+    int u,i,N=env->length,*cells;
+    bitMask used,cand,once,twice,thrice,missing,value=0;
+    for(u=0;u<3*N;u++){
+        used = u<N ? env->rows[u] : (u<2*N ? env->cols[u-N] : env->blocks[u-2*N]);
+        if(used==env->full)
+            continue;
+        cells = env->unitCells + u*N;
+        once = twice = thrice = 0;
+        for(i=0;i<N;i++){/*Values seen in at least one , two and three of the unit's unsolved cells*/
+            if(env->cellBits[cells[i]])
+                continue;
+            cand = bitCandidates(env,cells[i]);
+            thrice |= twice & cand;
+            twice |= once & cand;
+            once |= cand;
+        }
+        missing = env->full & ~used & ~once;
+        if(missing){/*A value with no place left*/
+            *unit = u;
+            *places = 0;
+            return missing & (~missing+1);
+        }
+        if(once & ~twice){
+            value = once & ~twice;
+            *unit = u;
+            break;
+        }
+        if(value==0 && (twice & ~thrice)){
+            value = twice & ~thrice;
+            *unit = u;
+        }
+    }
+    if(value==0)
+        return 0;
+    value &= ~value+1;
+    cells = env->unitCells + *unit*N;
+    *places = 0;
+    for(i=0;i<N;i++){
+        if(env->cellBits[cells[i]]==0 && (bitCandidates(env,cells[i])&value))
+            *places |= (bitMask)1<<i;
+    }
+    return value;
+}
+
+/**  moveToDepth:
+* @brief Moves an unsolved cell to position depth of the empties array
+* @param bitEnv *env - a pointer to the search environment
+* @param int depth - current depth of the search; empties from depth onwards are unsolved
+* @param int cell - the cell's index (row*N+col) , one of the unsolved cells
+* @return int - the cell's index
+*/
+int moveToDepth(bitEnv *env,int depth,int cell){
+    int i;
+    for(i=depth;env->empties[i]!=cell;i++);
+    env->empties[i] = env->empties[depth];
+    env->empties[depth] = cell;
+    return cell;
+}
+
+/**  lubyTerm:
+* @brief Computes a term of the Luby sequence 1,1,2,1,1,2,4,1,1,2,1,1,2,4,8,... - restart cutoffs that stay within a log
+*        factor of the best fixed cutoff , whatever the distribution of run lengths
+* @param unsigned long i - the term's index (1-based)
+* @return unsigned long - the term
+*/
+unsigned long lubyTerm(unsigned long i){
+    unsigned long k;
+    while(1){
+        for(k=1;((1UL<<k)-1)<i;k++);
+        if(i==(1UL<<k)-1)
+            return 1UL<<(k-1);
+        i -= (1UL<<(k-1))-1;
+    }
+}
+
+/**  recordBitSolution:
+* @brief Writes the values currently placed by the search , plus the last cell's value , into a solution array
+* @param bitEnv *env - a pointer to the search environment (at the last empty cell)
+* @param int **solution - a 2D array to get the solution
+* @param bitMask lastBit - the value placed in the last empty cell
+* @return void
+*/
+void recordBitSolution(bitEnv *env,int **solution,bitMask lastBit){
+    int d,cell,last=env->emptyCount-1;
+    for(d=0;d<last;d++){
+        cell = env->frames[d].cell;
+        solution[env->cellRow[cell]][env->cellCol[cell]] = bitValue(env->frames[d].placed);
+    }
+    cell = env->frames[last].cell;
+    solution[env->cellRow[cell]][env->cellCol[cell]] = bitValue(lastBit);
+}
+
+/**  bitValue:
+* @brief Converts a single value bit to the value it represents
+* @param bitMask bit - a mask with exactly one bit set
+* @return int - the value (1-based)
+*/
+int bitValue(bitMask bit){
+    int value=1;
+    while(bit>1){
+        bit >>= 1;
+        value++;
+    }
+    return value;
+}
+
+/**  randomBit:
+* @brief Picks one of the set bits of a mask at random
+* @param bitEnv *env - a pointer to the search environment (its generator is advanced)
+* @param bitMask mask - a mask with at least one bit set
+* @return bitMask - a mask with only the picked bit set
+*/
+bitMask randomBit(bitEnv *env,bitMask mask){
+    int k;
+    k = rngBelow(env->rng,BIT_POPCOUNT(mask));
+    while(k-->0){
+        mask &= mask-1;
+    }
+    return mask & (~mask+1);
+}
+
+/**  bitPopCount:
+* @brief Counts the set bits of a mask, for compilers without a popcount builtin
+* @param bitMask mask - the mask to count
+* @return int - number of set bits
+*/
+int bitPopCount(bitMask mask){
+    int count=0;
+    while(mask){
+        mask &= mask-1;
+        count++;
+    }
+    return count;
+}
@@ -0,0 +1,85 @@
+#ifndef BITSOLVER_H_INCLUDED
+#define BITSOLVER_H_INCLUDED
+#include "SudokuBoard.h"
+#include "solCount.h"
+#include "rng.h"
+
+/* A machine word holding one bit per board value (bit v-1 represents value v) */
+typedef unsigned long bitMask;
+
+/* The largest board side that fits a unit's occupancy in a single bitMask */
+#define BIT_MAX_LENGTH ((int)(sizeof(bitMask)*8))
+
+/* The order in which the search picks the next empty cell to branch on */
+typedef enum cellOrder{
+    rowMajor, mostConstrained
+}CELL_ORDER;
+
+/* A structure to represent a single frame of the bitmask search stack */
+/* Member: int cell - the board cell (row*N+col) this frame is solving */
+/* Member: bitMask remaining - candidate values for the cell that were not tried yet */
+/* Member: bitMask placed - the value currently placed in the cell (0 if none) */
+/* Member: int unit - -1 if the frame tries the candidates of its cell , o/w the unit (see unitCells) whose cells it tries value in */
+/* Member: bitMask value - the value the frame places in one of its unit's cells (remaining then holds the untried cells , bit i for the unit's i-th cell) */
+typedef struct bit_frame{
+    int cell;
+    bitMask remaining;
+    bitMask placed;
+    int unit;
+    bitMask value;
+}BitFrame;
+
+/* A structure to represent the state of the bitmask search engine */
+/* Member: int length - size of the board's sides */
+/* Member: CELL_ORDER order - how the next cell to solve is chosen */
+/* Member: bitMask full - a mask with all N value bits set */
+/* Member: bitMask *rows/cols/blocks - values already used in each row/column/block */
+/* Member: int *cellRow/cellCol/cellBlock - precomputed units of every cell */
+/* Member: int *empties - the cells that need solving (row-major after bitEnvInit , bitAssign/bitUnassign treat them as an unordered set) */
+/* Member: int emptyCount - number of cells in empties */
+/* Member: BitFrame *frames - the search stack, one frame per empty cell */
+/* Member: int *peers - for every cell, the peerCount cells sharing a row, column or block with it */
+/* Member: int peerCount - number of peers of each cell */
+/* Member: int *candCount - number of candidate values of every cell (maintained in mostConstrained order) */
+/* Member: int *unitCells - the N cells of every row , column and block (rows first , then columns , then blocks) */
+/* Member: bitMask *cellBits - the value placed in every cell , 0 for unsolved cells (maintained in mostConstrained order) */
+/* Member: int randomOrder - 1 if the search tries every cell's candidates in random order (see bitSample) , 0 for lowest first */
+/* Member: rngState *rng - the generator random orders are drawn from (must be set before bitSample , NULL by default) */
+/* Member: int resumeDepth - the depth a search was suspended at (see restartSearch) , -1 if none is */
+/* Member: unsigned long budget - values bitSolve/bitSample may place before giving up (0 , the default , for no limit) */
+typedef struct bit_env{
+    int length;
+    CELL_ORDER order;
+    bitMask full;
+    bitMask *rows;
+    bitMask *cols;
+    bitMask *blocks;
+    int *cellRow;
+    int *cellCol;
+    int *cellBlock;
+    int *empties;
+    int emptyCount;
+    BitFrame *frames;
+    int *peers;
+    int peerCount;
+    int *candCount;
+    int *unitCells;
+    bitMask *cellBits;
+    int randomOrder;
+    rngState *rng;
+    int resumeDepth;
+    unsigned long budget;
+}bitEnv;
+
+/*Public functions declarations*/
+int bitEnvInit(bitEnv *env,sudokuBoard *sBoard,CELL_ORDER order);
+void bitEnvFree(bitEnv *env);
+solCount bitCountSolutions(bitEnv *env,solCount limit);
+int bitSolve(bitEnv *env,int **solution);
+int bitSample(bitEnv *env,int **solution);
+int bitSinglesLeft(bitEnv *env);
+int bitChooseCell(bitEnv *env,bitMask *candidates);
+void bitAssign(bitEnv *env,int cell,bitMask bit);
+void bitUnassign(bitEnv *env,int cell,bitMask bit);
+
+#endif
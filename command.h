@@ -1,7 +1,10 @@
 #ifndef FINALPROJECT_COMMAND_H
 #define FINALPROJECT_COMMAND_H
 
-typedef enum commandType{solve,edit,mark_errors, set,printBoard,validate,guess,generate,undo,redo,save,hint,guess_hint,num_solutions,autofill,reset,ex }COMMAND_TYPE;
+/* Number of integer parameters of generate_batch */
+#define BATCH_PARAMS 7
+
+typedef enum commandType{solve,edit,mark_errors, set,printBoard,validate,guess,generate,generate_unique,generate_batch,randomSeed,undo,redo,save,hint,guess_hint,num_solutions,autofill,reset,solver_log,ex }COMMAND_TYPE;
 
 typedef struct command{
     COMMAND_TYPE commandType;
@@ -9,6 +12,7 @@ typedef struct command{
     int y;
     int z;
     float val;
+    int params[BATCH_PARAMS];
     char * fileName;
 }Command;
 
@@ -0,0 +1,327 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "dlxSolver.h"
+
+/*Private functions declarations*/
+solCount dlxSearch(sudokuBoard *sBoard,int **solution,solCount limit,rngState *rng);
+int buildMatrix(dlxMatrix *dlx,sudokuBoard *sBoard,rngState *rng);
+void freeMatrix(dlxMatrix *dlx);
+void addChoice(dlxMatrix *dlx,int *columns,int rowId);
+void shuffleOrder(int *order,int count,rngState *rng);
+void coverColumn(dlxMatrix *dlx,int col);
+void uncoverColumn(dlxMatrix *dlx,int col);
+int chooseColumn(dlxMatrix *dlx);
+void recordSolution(dlxMatrix *dlx,sudokuBoard *sBoard,int **solution,int depth);
+
+
+/**  dlxSolve:
+* @brief Solves the board as an exact-cover problem with Dancing Links (Knuth's Algorithm X)
+* @param sudokuBoard *sBoard - a pointer to the sudoku board being solved
+* @param int **solution - a 2D array to get the first solution found (can be NULL)
+* @param solCount limit - stop searching after this many solutions were found (0 for no limit)
+* @return solCount - the number of solutions found (up to limit , SOL_COUNT_MAX means at least that many)
+*/
+solCount dlxSolve(sudokuBoard *sBoard,int **solution,solCount limit){
+    return dlxSearch(sBoard,solution,limit,NULL);
+}
+
+/**  dlxSample:
+* @brief Finds a random solution of the board with Dancing Links - every cell's values are tried in random order
+* @param sudokuBoard *sBoard - a pointer to the sudoku board being solved
+* @param int **solution - a 2D array to get the solution
+* @param rngState *rng - the generator the orders are drawn from
+* @return int - 1 if a solution was found , 0 if the board has no solution
+*/
+int dlxSample(sudokuBoard *sBoard,int **solution,rngState *rng){
+    return dlxSearch(sBoard,solution,1,rng)>0;
+}
+
+/**  dlxSearch:
+* @brief Runs Algorithm X over the exact-cover matrix of the board
+* @param sudokuBoard *sBoard - a pointer to the sudoku board being solved
+* @param int **solution - a 2D array to get the first solution found (can be NULL)
+* @param solCount limit - stop searching after this many solutions were found (0 for no limit)
+* @param rngState *rng - the generator every cell's value order is drawn from , NULL to try values in order
+* @return solCount - the number of solutions found (up to limit , SOL_COUNT_MAX means at least that many)
+*/
+solCount dlxSearch(sudokuBoard *sBoard,int **solution,solCount limit,rngState *rng){
+    dlxMatrix dlx;
+    int depth=0,col,node,j,backtrack=0;
+    solCount count=0;
+    if(!buildMatrix(&dlx,sBoard,rng)){/*Set cells already conflict*/
+        freeMatrix(&dlx);
+        return 0;
+    }
+    if(limit==0)/*No limit - stop only if the counter would overflow*/
+        limit = SOL_COUNT_MAX;
+    while(depth>=0){
+        if(!backtrack){/*Going down - pick the next constraint to satisfy*/
+            if(dlx.right[0]==0){/*All constraints are satisfied*/
+                if(count==0 && solution!=NULL)
+                    recordSolution(&dlx,sBoard,solution,depth);
+                count++;
+                if(count>=limit)
+                    break;
+                backtrack = 1;
+                depth--;
+                continue;
+            }
+            col = chooseColumn(&dlx);
+            coverColumn(&dlx,col);
+            dlx.choices[depth] = dlx.down[col];
+        }
+        else{/*Going up - withdraw the choice made at this depth and try the next one*/
+            node = dlx.choices[depth];
+            for(j=dlx.left[node];j!=node;j=dlx.left[j])
+                uncoverColumn(&dlx,dlx.column[j]);
+            dlx.choices[depth] = dlx.down[node];
+        }
+        node = dlx.choices[depth];
+        col = dlx.column[node];
+        if(node==col){/*No more choices for this constraint*/
+            uncoverColumn(&dlx,col);
+            backtrack = 1;
+            depth--;
+            continue;
+        }
+        for(j=dlx.right[node];j!=node;j=dlx.right[j])
+            coverColumn(&dlx,dlx.column[j]);
+        backtrack = 0;
+        depth++;
+    }
+    freeMatrix(&dlx);
+    return count;
+}
+
+/**  buildMatrix:
+* @brief Builds the exact-cover matrix of a board: N^2 cell, N^2 row-value, N^2 column-value and N^2 block-value constraints
+* @param dlxMatrix *dlx - a pointer to the matrix being built
+* @param sudokuBoard *sBoard - a pointer to the sudoku board being solved
+* @param rngState *rng - the generator every cell's value order is drawn from , NULL to add values in order
+* @return int - 1 if the set cells of the board don't conflict , 0 o\w
+*/
+int buildMatrix(dlxMatrix *dlx,sudokuBoard *sBoard,rngState *rng){
+    int i,j,k,v,N,cell,block,cols,maxNodes,consistent=1,columns[4];
+    int ROWS=sBoard->rowsInBlock,COLS=sBoard->colsInBlock;
+    int *cells,*values;
+    char *satisfied;
+    N = sBoard->length;
+    cols = 4*N*N;
+    maxNodes = 1 + cols + 4*N*N*N;
+    dlx->left = (int*)malloc(maxNodes*sizeof(int));
+    dlx->right = (int*)malloc(maxNodes*sizeof(int));
+    dlx->up = (int*)malloc(maxNodes*sizeof(int));
+    dlx->down = (int*)malloc(maxNodes*sizeof(int));
+    dlx->column = (int*)malloc(maxNodes*sizeof(int));
+    dlx->rowId = (int*)malloc(maxNodes*sizeof(int));
+    dlx->size = (int*)calloc(cols+1,sizeof(int));
+    dlx->choices = (int*)malloc((N*N+1)*sizeof(int));
+    satisfied = (char*)calloc(cols+1,sizeof(char));
+    cells = (int*)malloc(N*N*sizeof(int));
+    values = (int*)malloc(N*sizeof(int));
+    if(!dlx->left || !dlx->right || !dlx->up || !dlx->down || !dlx->column || !dlx->rowId || !dlx->size || !dlx->choices || !satisfied || !cells || !values){
+        printf("Error: memory allocation has failed in buildMatrix, Exiting...\n");
+        exit(0);
+    }
+    /*Constraints already satisfied by set cells are left out of the matrix*/
+    for(i=0;i<N;i++){
+        for(j=0;j<N;j++){
+            v = CELL(sBoard,i,j).value-1;
+            if(v<0)
+                continue;
+            block = ROWS*(i/ROWS)+(j/COLS);
+            columns[0] = 1 + i*N+j;
+            columns[1] = 1 + N*N + i*N+v;
+            columns[2] = 1 + 2*N*N + j*N+v;
+            columns[3] = 1 + 3*N*N + block*N+v;
+            if(satisfied[columns[1]] || satisfied[columns[2]] || satisfied[columns[3]])
+                consistent = 0;
+            satisfied[columns[0]] = satisfied[columns[1]] = satisfied[columns[2]] = satisfied[columns[3]] = 1;
+        }
+    }
+    /*Link the root and the headers of the open constraints*/
+    dlx->left[0] = dlx->right[0] = 0;
+    for(i=1;i<=cols;i++){
+        dlx->up[i] = dlx->down[i] = dlx->column[i] = i;
+        dlx->rowId[i] = -1;
+        if(satisfied[i]){
+            dlx->left[i] = dlx->right[i] = i;
+            continue;
+        }
+        dlx->left[i] = dlx->left[0];
+        dlx->right[i] = 0;
+        dlx->right[dlx->left[0]] = i;
+        dlx->left[0] = i;
+    }
+    dlx->nodeCount = cols+1;
+    /*A row for every value that can still be placed in an empty cell - a column's rows are tried in the order they are
+      added , so a random order of cells and of every cell's values randomizes the search*/
+    for(cell=0;cell<N*N;cell++){
+        cells[cell] = cell;
+    }
+    for(v=0;v<N;v++){
+        values[v] = v;
+    }
+    if(rng!=NULL)
+        shuffleOrder(cells,N*N,rng);
+    for(k=0;k<N*N;k++){
+        i = cells[k]/N;
+        j = cells[k]%N;
+        if(CELL(sBoard,i,j).value!=0)
+            continue;
+        block = ROWS*(i/ROWS)+(j/COLS);
+        if(rng!=NULL)
+            shuffleOrder(values,N,rng);
+        for(v=0;v<N;v++){
+            columns[0] = 1 + i*N+j;
+            columns[1] = 1 + N*N + i*N+values[v];
+            columns[2] = 1 + 2*N*N + j*N+values[v];
+            columns[3] = 1 + 3*N*N + block*N+values[v];
+            if(satisfied[columns[1]] || satisfied[columns[2]] || satisfied[columns[3]])
+                continue;
+            addChoice(dlx,columns,(i*N+j)*N+values[v]);
+        }
+    }
+    free(satisfied);
+    free(cells);
+    free(values);
+    return consistent;
+}
+
+/**  freeMatrix:
+* @brief Frees all memory used by the exact-cover matrix
+* @param dlxMatrix *dlx - a pointer to the matrix
+* @return void
+*/
+void freeMatrix(dlxMatrix *dlx){
+    free(dlx->left);
+    free(dlx->right);
+    free(dlx->up);
+    free(dlx->down);
+    free(dlx->column);
+    free(dlx->rowId);
+    free(dlx->size);
+    free(dlx->choices);
+}
+
+/**  addChoice:
+* @brief Appends a matrix row of 4 nodes, one in each of the given columns
+* @param dlxMatrix *dlx - a pointer to the matrix
+* @param int *columns - the 4 constraints the choice satisfies
+* @param int rowId - the (cell,value) choice the row represents
+* @return void
+*/
+void addChoice(dlxMatrix *dlx,int *columns,int rowId){
+    int k,node,first=dlx->nodeCount,col;
+    for(k=0;k<4;k++){
+        node = dlx->nodeCount++;
+        col = columns[k];
+        dlx->column[node] = col;
+        dlx->rowId[node] = rowId;
+        /*vertical link - append at the bottom of the column*/
+        dlx->up[node] = dlx->up[col];
+        dlx->down[node] = col;
+        dlx->down[dlx->up[col]] = node;
+        dlx->up[col] = node;
+        dlx->size[col]++;
+        /*horizontal link - circular list of the row*/
+        dlx->left[node] = (k==0) ? node : node-1;
+        dlx->right[node] = first;
+        dlx->right[dlx->left[node]] = node;
+        dlx->left[first] = node;
+    }
+}
+
+/**  shuffleOrder:
+* @brief Puts an array in a uniformly random order (Fisher-Yates)
+* @param int *order - the array
+* @param int count - number of entries in the array
+* @param rngState *rng - the generator the order is drawn from
+* @return void
+*/
+void shuffleOrder(int *order,int count,rngState *rng){
+    int k,r,temp;
+    for(k=count-1;k>0;k--){
+        r = rngBelow(rng,k+1);
+        temp = order[k];
+        order[k] = order[r];
+        order[r] = temp;
+    }
+}
+
+/**  coverColumn:
+* @brief Removes a column and every row that intersects it from the matrix
+* @param dlxMatrix *dlx - a pointer to the matrix
+* @param int col - the column header to cover
+* @return void
+*/
+void coverColumn(dlxMatrix *dlx,int col){
+    int i,j;
+    dlx->right[dlx->left[col]] = dlx->right[col];
+    dlx->left[dlx->right[col]] = dlx->left[col];
+    for(i=dlx->down[col];i!=col;i=dlx->down[i]){
+        for(j=dlx->right[i];j!=i;j=dlx->right[j]){
+            dlx->down[dlx->up[j]] = dlx->down[j];
+            dlx->up[dlx->down[j]] = dlx->up[j];
+            dlx->size[dlx->column[j]]--;
+        }
+    }
+}
+
+/**  uncoverColumn:
+* @brief Restores a covered column, in exact reverse order of coverColumn
+* @param dlxMatrix *dlx - a pointer to the matrix
+* @param int col - the column header to uncover
+* @return void
+*/
+void uncoverColumn(dlxMatrix *dlx,int col){
+    int i,j;
+    for(i=dlx->up[col];i!=col;i=dlx->up[i]){
+        for(j=dlx->left[i];j!=i;j=dlx->left[j]){
+            dlx->size[dlx->column[j]]++;
+            dlx->down[dlx->up[j]] = j;
+            dlx->up[dlx->down[j]] = j;
+        }
+    }
+    dlx->right[dlx->left[col]] = col;
+    dlx->left[dlx->right[col]] = col;
+}
+
+/**  chooseColumn:
+* @brief Picks the open constraint with the fewest remaining choices
+* @param dlxMatrix *dlx - a pointer to the matrix
+* @return int - the chosen column header
+*/
+int chooseColumn(dlxMatrix *dlx){
+    int col,best,bestSize;
+    best = dlx->right[0];
+    bestSize = dlx->size[best];
+    for(col=dlx->right[best];col!=0 && bestSize>1;col=dlx->right[col]){
+        if(dlx->size[col]<bestSize){
+            best = col;
+            bestSize = dlx->size[col];
+        }
+    }
+    return best;
+}
+
+/**  recordSolution:
+* @brief Writes the board's set cells and the current choices into a solution array
+* @param dlxMatrix *dlx - a pointer to the matrix
+* @param sudokuBoard *sBoard - a pointer to the sudoku board being solved
+* @param int **solution - a 2D array to get the solution
+* @param int depth - number of choices currently made
+* @return void
+*/
+void recordSolution(dlxMatrix *dlx,sudokuBoard *sBoard,int **solution,int depth){
+    int i,j,d,id,N=sBoard->length;
+    for(i=0;i<N;i++){
+        for(j=0;j<N;j++){
+            solution[i][j] = CELL(sBoard,i,j).value;
+        }
+    }
+    for(d=0;d<depth;d++){
+        id = dlx->rowId[dlx->choices[d]];
+        solution[(id/N)/N][(id/N)%N] = (id%N)+1;
+    }
+}
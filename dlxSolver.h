@@ -0,0 +1,31 @@
+#ifndef DLXSOLVER_H_INCLUDED
+#define DLXSOLVER_H_INCLUDED
+#include "SudokuBoard.h"
+#include "solCount.h"
+#include "rng.h"
+
+/* A structure to represent the Dancing Links exact-cover matrix of a sudoku board */
+/* Nodes are kept in parallel arrays: index 0 is the root, 1..columns are column headers and the rest are matrix nodes */
+/* Member: int *left/right/up/down - the four links of every node */
+/* Member: int *column - the column header of every node */
+/* Member: int *rowId - the (cell,value) choice of every matrix node (cell*N + value-1) */
+/* Member: int *size - number of nodes currently linked in every column */
+/* Member: int nodeCount - number of nodes in use */
+/* Member: int *choices - the chosen node at each depth of the search */
+typedef struct dlx_matrix{
+    int *left;
+    int *right;
+    int *up;
+    int *down;
+    int *column;
+    int *rowId;
+    int *size;
+    int nodeCount;
+    int *choices;
+}dlxMatrix;
+
+/*Public functions declarations*/
+solCount dlxSolve(sudokuBoard *sBoard,int **solution,solCount limit);
+int dlxSample(sudokuBoard *sBoard,int **solution,rngState *rng);
+
+#endif
@@ -1,90 +1,128 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "ebSolver.h"
+#include "bitSolver.h"
+#include "parSolver.h"
 
 /*Private Stack functions declarations*/
-struct StackNode* newNode(int value,int cellIndex);
-int isEmpty(struct StackNode* root);
-void push(struct StackNode** root, int value,int cellIndex);
-void pop(struct StackNode** root);
+void initStack(SolverStack *stack,int capacity);
+void freeStack(SolverStack *stack);
+int isEmpty(SolverStack *stack);
+struct StackNode* push(SolverStack *stack,int value,int cellIndex);
+struct StackNode* pop(SolverStack *stack);
 
 /*Private Solver functions declarations*/
-int solverStack(sudokuBoard *sBoard,int* currValids,struct StackNode* stackTop);
+solCount solverStack(sudokuBoard *sBoard,int* currValids,SolverStack *stack,solCount limit);
 int updateValids(sudokuBoard *sBoard,int* currValids,int row,int col,int block,int minValue);
 void changeBoard(sudokuBoard *sBoard,int row,int col,int block,int index,int mod,int value);
 int findMinValid(int *currValids,int minVal,int N);
 
 
-/**  newNode:
-* @brief Creates a new StackNode
-* @param int value - value to define the new StackNode
-* @param int cellIndex - cellIndex to define the new StackNode
-* @return struct StackNode* - a new instance of a StackNode with value and cellIndex members
+/**  initStack:
+* @brief Allocates the frames of a stack once, for the whole search
+* @param SolverStack *stack - a pointer to the stack to initialize
+* @param int capacity - the maximal number of frames the stack will hold
+* @return void
 */
-struct StackNode* newNode(int value,int cellIndex)
+void initStack(SolverStack *stack,int capacity)
 {
-    struct StackNode* stackNode;
-    stackNode = (struct StackNode*)malloc(sizeof(struct StackNode));
-    stackNode->value = value;
-    stackNode->cellIndex = cellIndex;
-    stackNode->next = NULL;
-    return stackNode;
+    stack->frames = (struct StackNode*)malloc(capacity*sizeof(struct StackNode));
+    if(stack->frames==NULL){
+        printf("Error: memory allocation failure, Exiting...");
+        exit(0);
+    }
+    stack->capacity = capacity;
+    stack->top = -1;
+}
+
+/**  freeStack:
+* @brief Frees the frames of a stack
+* @param SolverStack *stack - a pointer to the stack
+* @return void
+*/
+void freeStack(SolverStack *stack)
+{
+    free(stack->frames);
+    stack->frames = NULL;
+    stack->top = -1;
 }
 
 /**  isEmpty:
 * @brief Checks if the stack is empty
-* @param struct StackNode* - a pointer to the root/top of the stack
+* @param SolverStack *stack - a pointer to the stack
 * @return int - 1 if the stack is empty , 0 o\w
 */
-int isEmpty(struct StackNode* root)
+int isEmpty(SolverStack *stack)
 {
-    return !root;
+    return stack->top<0;
 }
 
 /**  push:
-* @brief Adds a new node to the top of the stack
-* @param struct StackNode** root - a pointer to the root/top-of-the-stack pointer
-* @param int value - value to define the new StackNode being pushed
-* @param int cellIndex - cellIndex to define the new StackNode being pushed
-* @return void
+* @brief Adds a new frame to the top of the stack
+* @param SolverStack *stack - a pointer to the stack
+* @param int value - value to define the new frame being pushed
+* @param int cellIndex - cellIndex to define the new frame being pushed
+* @return struct StackNode* - the new top of the stack
 */
-void push(struct StackNode** root, int value ,int cellIndex)
+struct StackNode* push(SolverStack *stack,int value,int cellIndex)
 {
     struct StackNode* stackNode;
-    stackNode = newNode(value,cellIndex);
-    stackNode->next = *root;
-    *root = stackNode;
+    if(stack->top+1>=stack->capacity){
+        printf("Error: push to a full stack");
+        exit(0);
+    }
+    stackNode = &stack->frames[++stack->top];
+    stackNode->value = value;
+    stackNode->cellIndex = cellIndex;
+    return stackNode;
 }
 
 /**  pop:
-* @brief Removes a node from the top of the stack
-* @param struct StackNode** root - a pointer to the root/top-of-the-stack pointer
-* @return void
+* @brief Removes a frame from the top of the stack
+* @param SolverStack *stack - a pointer to the stack
+* @return struct StackNode* - the new top of the stack (NULL if it became empty)
 */
-void pop(struct StackNode** root)
+struct StackNode* pop(SolverStack *stack)
 {
-    if (isEmpty(*root)){
+    if (isEmpty(stack)){
         printf("Error: pop from empty stack");
         exit(0);
-    }else{
-        struct StackNode* temp = *root;
-        *root = (*root)->next;
-        free(temp);
     }
-    return ;
+    stack->top--;
+    return isEmpty(stack) ? NULL : &stack->frames[stack->top];
 }
 
 
 /**  solveStackEnv:
 * @brief The main function for game command num_solutions, serves as an envelope function for solveStack
 * @param sudokuBoard *sBoard - a pointer to the sudoku board being checked
-* @return int - the number of different valid solutions to the board
+* @return solCount - the number of different valid solutions to the board (SOL_COUNT_MAX means at least that many)
 */
-int solveStackEnv(sudokuBoard *sBoard){
-    struct StackNode* stackTop = NULL;
+solCount solveStackEnv(sudokuBoard *sBoard){
+    return countSolutions(sBoard,0);
+}
+
+/**  countSolutions:
+* @brief Counts the solutions of a board, stopping as soon as a given number of solutions was found
+* @param sudokuBoard *sBoard - a pointer to the sudoku board being checked
+* @param solCount limit - stop counting at this many solutions (0 for no limit)
+* @return solCount - the number of different valid solutions to the board , at most limit (SOL_COUNT_MAX means at least that many)
+*/
+solCount countSolutions(sudokuBoard *sBoard,solCount limit){
+    SolverStack stack;
     int *currValids;
-    int count;
+    solCount count;
     Index_Pair ip;
+    bitEnv env;
+    int threads;
+    if(sBoard->length<=BIT_MAX_LENGTH){/*Board units fit in a machine word - use the bitmask engine*/
+        threads = parThreadCount();
+        if(threads>1 && limit==0)/*Only a full count is worth spreading over threads*/
+            return parCountSolutions(sBoard,threads);
+        count = bitEnvInit(&env,sBoard,mostConstrained) ? bitCountSolutions(&env,limit) : 0;
+        bitEnvFree(&env);
+        return count;
+    }
     /*Check if board is full*/
     ip = find_empty_cell(sBoard);
     if (ip.x == -1 && ip.y==-1)
@@ -95,10 +133,12 @@ int solveStackEnv(sudokuBoard *sBoard){
         printf("Error: memory allocation failure, Exiting...");
         exit(0);
     }
-    push(&stackTop,0,0); /*Set a bottom marker for the stack*/
-    count = solverStack(sBoard,currValids,stackTop);
+    /*One frame per cell on top of the bottom marker - no allocations while searching*/
+    initStack(&stack,sBoard->length*sBoard->length+1);
+    push(&stack,0,0); /*Set a bottom marker for the stack*/
+    count = solverStack(sBoard,currValids,&stack,limit);
     free(currValids);
-    free(stackTop); /*maybe add check that stack is empty*/
+    freeStack(&stack);
     return count;
 }
 
@@ -106,29 +146,34 @@ int solveStackEnv(sudokuBoard *sBoard){
 * @brief The algorithmic function for num_solutions
 * @param sudokuBoard *sBoard - a pointer to the sudoku board being checked
 * @param int *currValids - a boolean array that represents valid options to a value and cell being checked
-* @param struct StackNode* stackTop - a pointer to the top StackNode of the recursion stack
-* @return int - the number of different valid solutions to the board
+* @param SolverStack *stack - a pointer to the recursion stack, holding only its bottom marker
+* @param solCount limit - stop counting at this many solutions (0 for no limit)
+* @return solCount - the number of different valid solutions to the board , at most limit
 */
-int solverStack(sudokuBoard *sBoard,int* currValids,struct StackNode* stackTop){
-    int count=0,N=sBoard->length;
+solCount solverStack(sudokuBoard *sBoard,int* currValids,SolverStack *stack,solCount limit){
+    solCount count=0;
+    int N=sBoard->length;
     int row,col,block,valids,pushFlag=1,ROWS,COLS;
+    struct StackNode* stackTop = &stack->frames[stack->top];
     ROWS=sBoard->rowsInBlock,COLS=sBoard->colsInBlock;
+    if(limit==0)/*No limit - stop only if the counter would overflow*/
+        limit = SOL_COUNT_MAX;
     do{
         if(pushFlag==1){/*Pushing Mode*/
             /*Work with current cell*/
             row = (stackTop->cellIndex)/N;
             col = (stackTop->cellIndex) - (row*N);
-            push(&stackTop,sBoard->board[row][col].value,(stackTop->cellIndex)+1);
+            stackTop = push(stack,CELL(sBoard,row,col).value,(stackTop->cellIndex)+1);
         }
         else{/*Popping Mode*/
-            pop(&stackTop);
+            stackTop = pop(stack);
             if(stackTop->cellIndex<1)
                 break; /*Reached bottom marker*/
             /*Work with previous cell*/
             row = (stackTop->cellIndex-1) / N;
             col = (stackTop->cellIndex-1) - (row*N);
         }
-        if((sBoard->board[row][col].userMod==0)&&(sBoard->board[row][col].fixed==0)){
+        if((CELL(sBoard,row,col).userMod==0)&&(CELL(sBoard,row,col).fixed==0)){
             /*Cell in need of solving: not fixed and not user-modified*/
             block = ROWS*(row/ROWS)+(col/COLS);
             valids = updateValids(sBoard,currValids,row,col,block,stackTop->value);
@@ -149,6 +194,8 @@ int solverStack(sudokuBoard *sBoard,int* currValids,struct StackNode* stackTop){
                 if((row==(N-1))&&(col==(N-1))){ /*End of board*/
                     count++;
                     pushFlag=0;
+                    if(count>=limit)
+                        break;
                 }
                 else{
                     changeBoard(sBoard,row,col,block,stackTop->value,1,stackTop->value+1);/*#define SET_CELL*/
@@ -161,9 +208,21 @@ int solverStack(sudokuBoard *sBoard,int* currValids,struct StackNode* stackTop){
             if((row==(N-1))&&(col==(N-1))){ /*End of board*/
                 count++;
                 pushFlag=0;
+                if(count>=limit)
+                    break;
             }
         }
     }while(stackTop->cellIndex!=0);
+    /*Stopped at the limit - clear the cells still set by the search and empty the stack*/
+    while(stackTop->cellIndex!=0){
+        row = (stackTop->cellIndex-1) / N;
+        col = (stackTop->cellIndex-1) - (row*N);
+        if((CELL(sBoard,row,col).userMod==0)&&(CELL(sBoard,row,col).fixed==0)&&(CELL(sBoard,row,col).value!=0)){
+            block = ROWS*(row/ROWS)+(col/COLS);
+            changeBoard(sBoard,row,col,block,CELL(sBoard,row,col).value-1,0,0);
+        }
+        stackTop = pop(stack);
+    }
     return count;
 }
 
@@ -179,7 +238,7 @@ int updateValids(sudokuBoard *sBoard,int* currValids,int row,int col,int block,i
     int i,N=sBoard->length;
     int valids = N - minValue;
     for(i=minValue;i<N;i++){
-        if((sBoard->invalidRows[row][i]==1)||(sBoard->invalidCols[col][i]==1)||(sBoard->invalidBlocks[block][i]==1)){
+        if(UNIT_HAS(sBoard,invalidRows,row,i)||UNIT_HAS(sBoard,invalidCols,col,i)||UNIT_HAS(sBoard,invalidBlocks,block,i)){
             /*For any reason why i might not be a valid value*/
             currValids[i]=0;
             valids--;
@@ -201,10 +260,19 @@ int updateValids(sudokuBoard *sBoard,int* currValids,int row,int col,int block,i
 * @return void
 */
 void changeBoard(sudokuBoard *sBoard,int row,int col,int block,int index,int mod,int value){
-    sBoard->board[row][col].value=value;
-    sBoard->invalidRows[row][index]=mod;
-    sBoard->invalidCols[col][index]=mod;
-    sBoard->invalidBlocks[block][index]=mod;
+    if((CELL(sBoard,row,col).value==0)!=(value==0))/*Keep the board's empty count in line*/
+        sBoard->counts->emptyCells += (value==0) ? 1 : -1;
+    CELL(sBoard,row,col).value=value;
+    if(mod){
+        UNIT_ADD(sBoard,invalidRows,row,index);
+        UNIT_ADD(sBoard,invalidCols,col,index);
+        UNIT_ADD(sBoard,invalidBlocks,block,index);
+    }
+    else{
+        UNIT_REMOVE(sBoard,invalidRows,row,index);
+        UNIT_REMOVE(sBoard,invalidCols,col,index);
+        UNIT_REMOVE(sBoard,invalidBlocks,block,index);
+    }
     return;
 }
 
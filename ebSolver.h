@@ -1,18 +1,28 @@
 #ifndef EBSOLVER_H_INCLUDED
 #define EBSOLVER_H_INCLUDED
 #include "SudokuBoard.h"
+#include "solCount.h"
 
-/* A structure to represent a stack to simulate recursion */
+/* A structure to represent a frame of the stack that simulates recursion */
 /* Member: int value - represents the currently checked sudoku board value (for this stackNode)*/
 /* Member: int cellIndex - represents the currently checked sudoku board cell */
-/* Member: StackNode* next - a pointer to the next Node in the stack*/
 struct StackNode {
 	int value;
 	int cellIndex;
-	struct StackNode* next;
 };
 
+/* A structure to represent a stack to simulate recursion, as one contiguous array of frames */
+/* Member: StackNode* frames - the frames of the stack, allocated once per search */
+/* Member: int top - index of the top frame (-1 if the stack is empty) */
+/* Member: int capacity - number of frames allocated */
+typedef struct solver_stack {
+	struct StackNode* frames;
+	int top;
+	int capacity;
+}SolverStack;
+
 /*Public functions*/
-int solveStackEnv(sudokuBoard *sBoard);
+solCount solveStackEnv(sudokuBoard *sBoard);
+solCount countSolutions(sudokuBoard *sBoard,solCount limit);
 
 #endif
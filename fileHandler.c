@@ -26,8 +26,12 @@ int fileToSudoku(sudokuBoard *newBoard, char *fileName) {
     }
 
 
-    if( m > 0 && n >0){
+    if( m > 0 && n >0 && m <= CELL_MAX_VALUE / n){
         get_empty_board(newBoard, m, n);
+    } else if( m > 0 && n > 0){
+        printf("Error: board is too large - its side can be at most %d\n", CELL_MAX_VALUE);
+        fclose(file);
+        return -1;
     } else{
         printf("Error: Wrong file format\n");
         fclose(file);
@@ -48,7 +52,7 @@ int fileToSudoku(sudokuBoard *newBoard, char *fileName) {
                 if (val >= 0 && val <= newBoard->length) {
                     setCell(newBoard, rowCount, colcount, val);
                     if (ch == '.') {
-                        newBoard->board[rowCount][colcount].fixed = 1;
+                        setCellFixed(newBoard, rowCount, colcount, 1);
                         fscanf(file, "%c", &ch);
                         if(!isspace(ch)){
                             printf("Error: Invalid value in file\n");
@@ -113,13 +117,13 @@ int sudokuToFile(sudokuBoard *sBoard, char *fileName, int fixAll) {
     /*write all values into file*/
     for (i = 0; i < sBoard->length; i++) {
         for (j = 0; j < sBoard->length; j++) {
-            fprintf(file, "%d", sBoard->board[i][j].value);
+            fprintf(file, "%d", CELL(sBoard,i,j).value);
             if (fixAll) {
-                if (sBoard->board[i][j].value != 0) {
+                if (CELL(sBoard,i,j).value != 0) {
                     fprintf(file, ".");
                 }
             } else {
-                if (sBoard->board[i][j].fixed) {
+                if (CELL(sBoard,i,j).fixed) {
                     fprintf(file, ".");
                 }
             }
@@ -134,3 +138,25 @@ int sudokuToFile(sudokuBoard *sBoard, char *fileName, int fixAll) {
     return 1;
 
 }
+
+/*writes a puzzle to an open stream in the sudokuToFile format, every filled cell fixed (puzzles can be written one after another)*/
+void puzzleToStream(FILE *file, int m, int n, int **values) {
+
+    int i, j, len = m * n;
+
+    fprintf(file, "%d %d\n", m, n);
+
+    for (i = 0; i < len; i++) {
+        for (j = 0; j < len; j++) {
+            fprintf(file, "%d", values[i][j]);
+            if (values[i][j] != 0) {
+                fprintf(file, ".");
+            }
+            if (j != len - 1) {
+                fprintf(file, " ");
+            }
+        }
+        fprintf(file, "\n");
+    }
+
+}
@@ -1,10 +1,12 @@
 #ifndef FILEHANDLER_H_INCLUDED
 #define FILEHANDLER_H_INCLUDED
+#include <stdio.h>
 #include "SudokuBoard.h"
 
 
 /*Public functions declarations*/
 int fileToSudoku(sudokuBoard * sudokuBoard,char * fileName);
 int sudokuToFile(sudokuBoard* sudokuBoard, char * fileName, int fixAll);
+void puzzleToStream(FILE *file, int m, int n, int **values);
 
 #endif
@@ -11,6 +11,7 @@ int canEditSudoku(char *fileName);
 int isInputEmpty(char *input);
 int checkMode(sudokuGame *game, Command *command);
 int isPrintTypeCommand(Command *command);
+void guessFailure(sudokuGame *game, char *commandName);
 
 /**  solveCommand:
 * @brief Loads a board from a file to the current board of the sudoku game in solve mode
@@ -152,6 +153,29 @@ int markErrorsCommand(sudokuGame *game, int x) {
 
 }
 
+/**  solverLogCommand:
+* @brief Turns the LP solver's log and model files on/off
+* @param sudokuGame* game - a pointer to a sudoku game
+* @param int x - the new value of solver_log of a sudoku game (ranged 0-1)
+* @return 1 if successful, 0 o/w
+*/
+int solverLogCommand(sudokuGame *game, int x) {
+    setSolverLog(game, x);
+    return 1;
+
+}
+
+/**  seedCommand:
+* @brief Restarts the game's random generator from a seed , so the game's random choices (generate , guess ...) can be repeated
+* @param sudokuGame* game - a pointer to a sudoku game
+* @param int x - the seed
+* @return 1 if successful, 0 o/w
+*/
+int seedCommand(sudokuGame *game, int x) {
+    setSeed(game, (unsigned long) x);
+    return 1;
+}
+
 /**  printBoardCommand:
 * @brief Prints the current board of the game
 * @param sudokuGame* game - a pointer to a sudoku game
@@ -208,7 +232,7 @@ int saveCommand(sudokuGame *game, char *fileName) {
             printf("Error: save is not available in edit mode while board is erroneous\n");
             return 0;
         }
-        if (ILPSolver(game)) {
+        if (solveBoard(game)) {
             return sudokuToFile(game->currBoard, fileName, 1);
         } else {
             printf("Error: save is not available, board has no solution\n");
@@ -225,14 +249,13 @@ int saveCommand(sudokuGame *game, char *fileName) {
 * @return 1 if successful, 0 o/w
 */
 int guessCommand(sudokuGame *game, float x) {
+    const solverBackend *backend = findSolver(lpGuess);
     if (isBoardError(game->currBoard)) {
         printf("Error: guess is not available while board is erroneous\n");
         return 0;
-    } else {
-        if (!LPSolverGuess(game, x)) {
-            printf("Error: LP solver has crashed\n");
-            return 0;
-        }
+    } else if (!backend->guess(game, x)) {
+        guessFailure(game, "guess");
+        return 0;
     }
     return 1;
 }
@@ -245,24 +268,37 @@ int guessCommand(sudokuGame *game, float x) {
 * @return 1 if successful, 0 o/w
 */
 int guessHintCommand(sudokuGame *game, int row, int col) {
+    const solverBackend *backend = findSolver(lpGuess);
     if (isBoardError(game->currBoard)) {
         printf("Error: guess is not available while board is erroneous\n");
         return 0;
-    } else if (game->currBoard->board[row][col].fixed == 1) {
+    } else if (CELL(game->currBoard,row,col).fixed == 1) {
         printf("Error: can't guess hint a fixed cell\n");
         return 0;
-    } else if (game->currBoard->board[row][col].userMod == 1) {
+    } else if (CELL(game->currBoard,row,col).userMod == 1) {
         printf("Error: can't guess hint a user modified cell\n");
         return 0;
-    } else {
-        if (!LPSolverGuessHint(game, row, col)) {
-            printf("Error: LP solver has crashed\n");
-            return 0;
-        }
+    } else if (!backend->guessHint(game, row, col)) {
+        guessFailure(game, "guess_hint");
+        return 0;
     }
     return 1;
 }
 
+/**  guessFailure:
+* @brief Tells the user why a guess backend has failed - the board has no solution , or the LP solver has crashed
+*        (the sampling backend only fails on boards with no solution)
+* @param sudokuGame* game - a pointer to a sudoku game
+* @param char* commandName - the name of the failed command
+* @return void
+*/
+void guessFailure(sudokuGame *game, char *commandName) {
+    if (!solveBoard(game))
+        printf("Error: %s has failed - the board has no solution\n", commandName);
+    else
+        printf("Error: LP solver has crashed\n");
+}
+
 /**  validateCommand:
 * @brief Validates if the current board is solvable or not
 * @param sudokuGame* game - a pointer to a sudoku game
@@ -273,7 +309,7 @@ int validateCommand(sudokuGame *game) {
         printf("Error: validate is not available while board is erroneous\n");
         return 0;
     }
-    if (ILPSolver(game))
+    if (solveBoard(game))
         printf("Board is solvable\n");
     else
         printf("Board is unsolvable\n");
@@ -286,99 +322,132 @@ int validateCommand(sudokuGame *game) {
 * @return 1 if successful, 0 o/w
 */
 int numOfSolutionsCommand(sudokuGame *game) {
+    solCount count;
     if (isBoardError(game->currBoard)) {
         printf("Error: num_solutions is not available while board is erroneous\n");
         return 0;
     }
-    printf("The board has %d different solutions\n", solveStackEnv(game->currBoard));
+    count = solveStackEnv(game->currBoard);
+    if (count == SOL_COUNT_MAX) {
+        printf("The board has >= %lu different solutions (counting stopped at the counter's limit)\n", count);
+    } else {
+        printf("The board has %lu different solutions\n", count);
+    }
     return 1;
 }
 
 /**  generateCommand:
-* @brief Generates a new sudoku board to the sudoku game
+* @brief Generates a new sudoku board to the sudoku game - a random solution of the board is found in a single pass
+*        and y of its cells , picked at random , are kept
 * @param sudokuGame* game - a pointer to a sudoku game
-* @param int x - number of legal values to add to the board before solving (randomization effect)
+* @param int x - number of empty cells the board must have (the random solution takes the place of x random values)
 * @param int y - number of cells filled for the newly generated sudoku board
 * @return 1 if successful, 0 o/w
 */
 int generateCommand(sudokuGame *game, int x, int y) {
-    int emptyCells, row, col, N, xCount, yCount, i, j, value;
-    sudokuBoard *tempBoard, *swapBoard;
+    int emptyCells, N, i, j, cell, keep, value;
     N = game->currBoard->length;
-    tempBoard = (sudokuBoard *) malloc((sizeof(sudokuBoard)));
-    if(tempBoard == NULL){
-        printf("Error: failed to allocate memory in generateCommand, Exiting...\n");
-        exit(0);
-    }
-    get_empty_board(tempBoard, game->currBoard->rowsInBlock, game->currBoard->colsInBlock);
-    copy_boards(game->currBoard, tempBoard);
     emptyCells = countEmptyCells(game->currBoard);
-    yCount = (N * N) - y;
     if (emptyCells < x) {
         printf("Error: not enough empty cells for parameter X:%d\n", x);
         return 0;
     } else if (isBoardError(game->currBoard)) {
         printf("Error: generate is not available when board is erroneous\n");
         return 0;
-    } else {
-        for (i = 0; i < 1000; i++) {
-            xCount = x;
-            while (xCount > 0) {
-                row = rand() % N;
-                col = rand() % N;
-                if (game->currBoard->board[row][col].fixed == 0 && game->currBoard->board[row][col].value == 0) {
-                    value = randomizeLegalValue(game->currBoard, row, col);
-                    if (value == -1) {
-                        copy_boards(tempBoard, game->currBoard);
-                        break;
-                    }
-                    setCell(game->currBoard, row, col, value);
-                    xCount--;
-                }
-            }
-            if (ILPSolver(game)) {
-                for (i = 0; i < N; i++) {
-                    for (j = 0; j < N; j++) {
-                        if (game->currBoard->board[i][j].fixed == 0 && game->currBoard->board[i][j].value == 0) {
-                            setCell(game->currBoard, i, j, game->currSol[i][j]);
-                        }
-                    }
-                }
-                break;
-            } else {
-                copy_boards(tempBoard, game->currBoard);
-            }
-        }
-        if (i == 1000) {
-            printf("Error: after 1000 iteration - generate has failed\n");
-            return 0;
-        }
-        /*All X cells got legal values and ILPSolver was successful*/
-        while (yCount > 0) {
-            row = rand() % N;
-            col = rand() % N;
-            if (game->currBoard->board[row][col].value != 0) {
-                /*FORMER FIXED CHECK*/
-                if (game->currBoard->board[row][col].fixed == 1) {
-                    game->currBoard->board[row][col].fixed = 0;
-                }
-                setCell(game->currBoard, row, col, 0);
-                yCount--;
-            }
-        }
-        /*SWAP BOARDS*/
-        swapBoard = game->currBoard;
-        game->currBoard = tempBoard;
-        tempBoard = swapBoard;
-        pushGameMove(game);
-        for (i = 0; i < N; i++) {
-            for (j = 0; j < N; j++) {
-                if (game->currBoard->board[i][j].value != tempBoard->board[i][j].value)
-                    gameSetCell(game, i, j, tempBoard->board[i][j].value, 1);
-            }
+    } else if (!randomSolveBoard(game)) {
+        printf("Error: generate has failed - the board has no solution\n");
+        return 0;
+    }
+    /*Keep y cells of the solution - every cell is kept with chance (cells left to keep)/(cells left to visit)*/
+    pushGameMove(game);
+    keep = y;
+    for (cell = 0; cell < N * N; cell++) {
+        i = cell / N;
+        j = cell % N;
+        value = 0;
+        if (rngBelow(&game->rng, N * N - cell) < keep) {
+            value = game->currSol[i][j];
+            keep--;
+        }
+        if (CELL(game->currBoard,i,j).value != value)
+            gameSetCell(game, i, j, value, 1);
+    }
+    return 1;
+}
+
+/**  generateUniqueCommand:
+* @brief Generates a new sudoku board with a single solution - clues of a random solution are removed one at a time
+*        (or in symmetric pairs) while the board stays uniquely solvable , until the clue or difficulty target is met (see genPuzzle)
+* @param sudokuGame* game - a pointer to a sudoku game
+* @param int y - target number of clues - removal stops once the board has this many cells filled
+* @param int d - target difficulty (see bitSinglesLeft) - removal stops once the board is this hard (0 for no target)
+* @param int symmetric - 1 to remove clues in pairs that map to each other under a half turn of the board , 0 o/w
+* @return 1 if successful, 0 o/w
+*/
+int generateUniqueCommand(sudokuGame *game, int y, int d, int symmetric) {
+    int N, i, cell, clues, difficulty;
+    int *order, **values;
+    sudokuBoard *shape;
+    bitEnv env;
+    N = game->currBoard->length;
+    if (N > BIT_MAX_LENGTH) {
+        printf("Error: generate_unique boards can be at most %d wide\n", BIT_MAX_LENGTH);
+        return 0;
+    } else if (isBoardError(game->currBoard)) {
+        printf("Error: generate_unique is not available when board is erroneous\n");
+        return 0;
+    } else if (!randomSolveBoard(game)) {
+        printf("Error: generate_unique has failed - the board has no solution\n");
+        return 0;
+    }
+    shape = (sudokuBoard *) malloc(sizeof(sudokuBoard));
+    order = (int *) malloc(N * N * sizeof(int));
+    values = (int **) malloc(N * sizeof(int *));
+    if (shape == NULL || order == NULL || values == NULL) {
+        printf("Error: memory allocation has failed in generateUniqueCommand, Exiting...\n");
+        exit(0);
+    }
+    for (i = 0; i < N; i++) {
+        values[i] = (int *) malloc(N * sizeof(int));
+        if (values[i] == NULL) {
+            printf("Error: memory allocation has failed in generateUniqueCommand, Exiting...\n");
+            exit(0);
         }
+        memcpy(values[i], game->currSol[i], N * sizeof(int));
+    }
+    /*Every cell of the solution may be removed , so the clues are tried on an empty board of the game's shape*/
+    get_empty_board(shape, game->currBoard->rowsInBlock, game->currBoard->colsInBlock);
+    bitEnvInit(&env, shape, mostConstrained);
+    env.rng = &game->rng;
+    clues = genPuzzle(&env, values, order, y, d, symmetric);
+    difficulty = bitSinglesLeft(&env);
+    bitEnvFree(&env);
+    freeBoard(shape);
+    pushGameMove(game);
+    for (cell = 0; cell < N * N; cell++) {
+        if (CELL(game->currBoard,cell / N,cell % N).value != values[cell / N][cell % N])
+            gameSetCell(game, cell / N, cell % N, values[cell / N][cell % N], 1);
+    }
+    for (i = 0; i < N; i++) {
+        free(values[i]);
+    }
+    free(values);
+    free(order);
+    printf("Generated a board with %d clues and difficulty %d\n", clues, difficulty);
+    return 1;
+}
+
+/**  generateBatchCommand:
+* @brief Generates a batch of single-solution puzzles into a file , on all cores (the game itself is left alone)
+* @param char* fileName - a string representing the name of file to write the puzzles to
+* @param int* params - block rows , block columns , number of puzzles , clue target , difficulty target , symmetry (0/1) and seed
+* @return 1 if successful, 0 o/w
+*/
+int generateBatchCommand(char *fileName, int *params) {
+    if (!generateBatch(fileName, params[0], params[1], params[2], params[3], params[4], params[5], (unsigned long) params[6])) {
+        return 0;
     }
-    freeBoard(tempBoard);
+    printf("Generated %d boards into %s\n", params[2], fileName);
     return 1;
 }
 
@@ -393,15 +462,15 @@ int hintCommand(sudokuGame *game, int row, int col) {
     if (isBoardError(game->currBoard)) {
         printf("Error: guess is not available while board is erroneous\n");
         return 0;
-    } else if (game->currBoard->board[row][col].fixed == 1) {
+    } else if (CELL(game->currBoard,row,col).fixed == 1) {
         printf("Error: can't guess hint a fixed cell\n");
         return 0;
-    } else if (game->currBoard->board[row][col].userMod == 1) {
+    } else if (CELL(game->currBoard,row,col).userMod == 1) {
         printf("Error: can't guess hint a user modified cell\n");
         return 0;
     } else {
-        if (!ILPSolver(game)) {
-            printf("Error: ILP solver has crashed\n");
+        if (!solveBoard(game)) {
+            printf("Error: board is unsolvable\n");
             return 0;
         }
         printf("Hinted value for cell <%d,%d> is %d\n", col + 1, row + 1, game->currSol[row][col]);
@@ -453,8 +522,8 @@ int autofillCommand(sudokuGame *game) {
 
     for (i = 0; i < len; i++) {
         for (j = 0; j < len; j++) {
-            if (values[i][j] != -1 && game->currBoard->board[i][j].fixed == 0 &&
-                game->currBoard->board[i][j].value == 0) {
+            if (values[i][j] != -1 && CELL(game->currBoard,i,j).fixed == 0 &&
+                CELL(game->currBoard,i,j).value == 0) {
                 gameSetCell(game, i, j, values[i][j], 1);
             }
         }
@@ -559,6 +628,16 @@ int checkMode(sudokuGame *game, Command *command) {
             } else {
                 return 1;
             }
+        case generate_unique:
+            if (game->mode == init) {
+                puts("Error: generate_unique is unavailable in INIT mode, only on EDIT mode");
+                return 0;
+            } else if (game->mode == so) {
+                puts("Error: generate_unique is unavailable in SOLVE mode, only on EDIT mode");
+                return 0;
+            } else {
+                return 1;
+            }
         case undo:
             if (game->mode == init) {
                 puts("Error: undo is unavailable in INIT mode, only on SOLVE and EDIT mode");
@@ -619,6 +698,12 @@ int checkMode(sudokuGame *game, Command *command) {
                 return 0;
             }
             return 1;
+        case solver_log:
+            return 1;
+        case generate_batch:
+            return 1;
+        case randomSeed:
+            return 1;
         case ex:
             return 1;
     }
@@ -630,7 +715,8 @@ int checkMode(sudokuGame *game, Command *command) {
 int isPrintTypeCommand(Command *command) {
     if (command->commandType == edit || command->commandType == solve || command->commandType == set ||
         command->commandType == autofill || command->commandType == redo || command->commandType == undo ||
-        command->commandType == generate || command->commandType == guess || command->commandType == reset) {
+        command->commandType == generate || command->commandType == generate_unique ||
+        command->commandType == guess || command->commandType == reset) {
         return 1;
     }
     return 0;
@@ -751,6 +837,18 @@ int gameTurn(sudokuGame *game) {
             isSuccess = generateCommand(game, command->x, command->y);
             break;
         }
+        case generate_unique: {
+            isSuccess = generateUniqueCommand(game, command->x, command->y, command->z);
+            break;
+        }
+        case generate_batch: {
+            isSuccess = generateBatchCommand(command->fileName, command->params);
+            break;
+        }
+        case randomSeed: {
+            isSuccess = seedCommand(game, command->x);
+            break;
+        }
         case save: {
             isSuccess = saveCommand(game, command->fileName);
             break;
@@ -776,6 +874,10 @@ int gameTurn(sudokuGame *game) {
             isSuccess = resetCommand(game);
             break;
         }
+        case solver_log: {
+            isSuccess = solverLogCommand(game, command->x);
+            break;
+        }
         case ex: {
             exitCommand(game);
             free(input);
@@ -5,14 +5,17 @@
 #include "MoveNode.h"
 #include "parser.h"
 #include "fileHandler.h"
-#include "LPSolver.h"
+#include "solver.h"
 #include "ebSolver.h"
+#include "generator.h"
 
 
 /*Public functions declarations*/
 int solveCommand(sudokuGame *game, char *fileName);
 int editCommand(sudokuGame *game, char *fileName);
 int markErrorsCommand(sudokuGame *game, int x);
+int solverLogCommand(sudokuGame *game, int x);
+int seedCommand(sudokuGame *game, int x);
 int printBoardCommand(sudokuGame *game);
 int setGameCommand(sudokuGame *game, int row, int col, int val);
 int undoCommand(sudokuGame *game);
@@ -23,6 +26,8 @@ int guessHintCommand(sudokuGame *game, int row, int col);
 int validateCommand(sudokuGame *game);
 int numOfSolutionsCommand(sudokuGame *game);
 int generateCommand(sudokuGame *game, int x, int y);
+int generateUniqueCommand(sudokuGame *game, int y, int d, int symmetric);
+int generateBatchCommand(char *fileName, int *params);
 int hintCommand(sudokuGame *game, int row, int col);
 int autofillCommand(sudokuGame *game);
 int resetCommand(sudokuGame *game);
@@ -0,0 +1,269 @@
+#define _POSIX_C_SOURCE 200112L
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "generator.h"
+#include "bitSolver.h"
+#include "parSolver.h"
+#include "fileHandler.h"
+
+/* A structure to represent a batch of puzzles generated by a pool of threads */
+/* Member: sudokuBoard *shape - an empty board of the batch's shape (read only) */
+/* Member: int count - number of puzzles to generate */
+/* Member: int clues/difficulty/symmetric - the targets of every puzzle (see genPuzzle) */
+/* Member: unsigned long seed - puzzle k is generated from its own generator , seeded by seed and k */
+/* Member: FILE *file - the stream puzzles are written to , in index order */
+/* Member: int next - index of the next puzzle to hand out */
+/* Member: int ***pending - puzzles done before all puzzles ahead of them , by index (NULL if not done or already written) */
+/* Member: int nextToWrite - index of the next puzzle to write */
+/* Member: pthread_mutex_t lock - guards next , pending , nextToWrite and file */
+typedef struct gen_batch{
+    sudokuBoard *shape;
+    int count;
+    int clues;
+    int difficulty;
+    int symmetric;
+    unsigned long seed;
+    FILE *file;
+    int next;
+    int ***pending;
+    int nextToWrite;
+    pthread_mutex_t lock;
+}genBatch;
+
+/*Private functions declarations*/
+void *runGenerator(void *arg);
+void setClue(bitEnv *env,int **values,int cell,int assign);
+int **allocPuzzle(int N);
+void freePuzzle(int **values,int N);
+
+
+/**  generateBatch:
+* @brief Generates puzzles with a single solution on a pool of threads and streams them to a file , one after another in
+*        the sudokuToFile format (in index order - the same seed gives the same file on any number of cores)
+* @param char *fileName - the file to write the puzzles to
+* @param int m/n - the block shape of the puzzles (m*n must be at most BIT_MAX_LENGTH)
+* @param int count - number of puzzles to generate
+* @param int clues - target number of clues (see genPuzzle)
+* @param int difficulty - target difficulty , 0 for none (see genPuzzle)
+* @param int symmetric - 1 for clue patterns symmetric under a half turn of the board , 0 o/w
+* @param unsigned long seed - the batch's seed
+* @return int - 1 if the puzzles were written , 0 o/w
+*/
+int generateBatch(char *fileName,int m,int n,int count,int clues,int difficulty,int symmetric,unsigned long seed){
+    genBatch batch;
+    pthread_t *threads;
+    int i,threadCount,started;
+    if(m>BIT_MAX_LENGTH/n){
+        printf("Error: generate_batch boards can be at most %d wide\n",BIT_MAX_LENGTH);
+        return 0;
+    }
+    if(clues>m*n*m*n || difficulty>m*n*m*n){
+        printf("Error: clue and difficulty targets must be between 0 and %d for this shape\n",m*n*m*n);
+        return 0;
+    }
+    batch.file = fopen(fileName,"w");
+    if(batch.file==NULL){
+        printf("Error: failed to open file: %s\n",fileName);
+        return 0;
+    }
+    batch.shape = (sudokuBoard *) malloc(sizeof(sudokuBoard));
+    if(batch.shape==NULL){
+        printf("Error: memory allocation has failed in generateBatch, Exiting...\n");
+        exit(0);
+    }
+    get_empty_board(batch.shape,m,n);
+    batch.count = count;
+    batch.clues = clues;
+    batch.difficulty = difficulty;
+    batch.symmetric = symmetric;
+    batch.seed = seed;
+    batch.next = 0;
+    batch.nextToWrite = 0;
+    batch.pending = (int ***) calloc(count,sizeof(int **));
+    if(batch.pending==NULL){
+        printf("Error: memory allocation has failed in generateBatch, Exiting...\n");
+        exit(0);
+    }
+    pthread_mutex_init(&batch.lock,NULL);
+    threadCount = parThreadCount();
+    if(threadCount>count)
+        threadCount = count;
+    threads = (pthread_t *) malloc(threadCount*sizeof(pthread_t));
+    if(threads==NULL){
+        printf("Error: memory allocation has failed in generateBatch, Exiting...\n");
+        exit(0);
+    }
+    /*The calling thread generates too; if a thread can't be started the others take its share*/
+    started = 1;
+    for(i=1;i<threadCount;i++){
+        if(pthread_create(&threads[i],NULL,runGenerator,&batch)!=0)
+            break;
+        started++;
+    }
+    runGenerator(&batch);
+    for(i=1;i<started;i++){
+        pthread_join(threads[i],NULL);
+    }
+    pthread_mutex_destroy(&batch.lock);
+    free(threads);
+    free(batch.pending);
+    freeBoard(batch.shape);
+    fclose(batch.file);
+    return 1;
+}
+
+/**  runGenerator:
+* @brief A generating thread: takes the batch's puzzles one at a time , and writes every puzzle whose turn has come
+*        (a puzzle done ahead of its turn is left in the batch's pending puzzles , for the thread that fills the gap)
+* @param void *arg - a pointer to the genBatch
+* @return void* - NULL
+*/
+void *runGenerator(void *arg){
+    genBatch *batch = (genBatch*)arg;
+    bitEnv env;
+    rngState rng;
+    int **values,*order;
+    int k,N=batch->shape->length;
+    order = (int*)malloc(N*N*sizeof(int));
+    if(order==NULL){
+        printf("Error: memory allocation has failed in runGenerator, Exiting...\n");
+        exit(0);
+    }
+    values = allocPuzzle(N);
+    while(1){
+        pthread_mutex_lock(&batch->lock);
+        k = batch->next<batch->count ? batch->next++ : -1;
+        pthread_mutex_unlock(&batch->lock);
+        if(k==-1)
+            break;
+        /*A fresh environment and generator for every puzzle, so a puzzle doesn't depend on the thread that made it*/
+        bitEnvInit(&env,batch->shape,mostConstrained);
+        rngSeedStream(&rng,batch->seed,(unsigned long)k);
+        env.rng = &rng;
+        bitSample(&env,values);
+        genPuzzle(&env,values,order,batch->clues,batch->difficulty,batch->symmetric);
+        bitEnvFree(&env);
+        pthread_mutex_lock(&batch->lock);
+        if(k==batch->nextToWrite){
+            puzzleToStream(batch->file,batch->shape->rowsInBlock,batch->shape->colsInBlock,values);
+            batch->nextToWrite++;
+        }
+        else{/*The pending puzzle keeps the buffer , and the thread takes a new one*/
+            batch->pending[k] = values;
+            values = NULL;
+        }
+        while(batch->nextToWrite<batch->count && batch->pending[batch->nextToWrite]!=NULL){
+            puzzleToStream(batch->file,batch->shape->rowsInBlock,batch->shape->colsInBlock,batch->pending[batch->nextToWrite]);
+            freePuzzle(batch->pending[batch->nextToWrite],N);
+            batch->pending[batch->nextToWrite++] = NULL;
+        }
+        pthread_mutex_unlock(&batch->lock);
+        if(values==NULL)
+            values = allocPuzzle(N);
+    }
+    freePuzzle(values,N);
+    free(order);
+    return NULL;
+}
+
+/**  genPuzzle:
+* @brief Generates a puzzle with a single solution - the clues of a full solution are tried one at a time (or in
+*        symmetric pairs) in random order , and each is removed if the board stays uniquely solvable , until a target is met
+* @param bitEnv *env - a pointer to an environment of an empty board , with its generator set (the puzzle's clues are left in it)
+* @param int **values - a 2D array holding a full solution of the board , turned into the puzzle (0 for empty cells)
+* @param int *order - scratch space for N*N cell indices
+* @param int clues - removal stops once the puzzle has this many clues
+* @param int difficulty - removal stops once the puzzle is this hard (see bitSinglesLeft) , 0 for no target
+* @param int symmetric - 1 to remove clues in pairs that map to each other under a half turn of the board , 0 o/w
+* @return int - the number of clues in the puzzle
+*/
+int genPuzzle(bitEnv *env,int **values,int *order,int clues,int difficulty,int symmetric){
+    int N=env->length,k,cell,pair,removed,count,temp,score=0;
+    for(cell=0;cell<N*N;cell++){/*Every cell of the solution starts as a clue*/
+        setClue(env,values,cell,1);
+        order[cell] = cell;
+    }
+    for(cell=N*N-1;cell>0;cell--){/*Every cell is tried once , in random order*/
+        k = rngBelow(env->rng,cell+1);
+        temp = order[cell];
+        order[cell] = order[k];
+        order[k] = temp;
+    }
+    count = N*N;
+    for(k=0;k<N*N && count>clues && (difficulty==0 || score<difficulty);k++){
+        cell = order[k];
+        pair = symmetric ? N*N-1-cell : cell;
+        removed = (pair==cell) ? 1 : 2;
+        if(pair<cell || count-removed<clues)/*A pair is tried from its lower cell*/
+            continue;
+        setClue(env,values,cell,0);
+        if(pair!=cell)
+            setClue(env,values,pair,0);
+        if(bitCountSolutions(env,2)==1){
+            count -= removed;
+            values[cell/N][cell%N] = 0;
+            values[pair/N][pair%N] = 0;
+            if(difficulty>0)
+                score = bitSinglesLeft(env);
+        }
+        else{
+            if(pair!=cell)
+                setClue(env,values,pair,1);
+            setClue(env,values,cell,1);
+        }
+    }
+    return count;
+}
+
+/**  setClue:
+* @brief Puts a cell's solution value in the environment as a clue , or takes it out
+* @param bitEnv *env - a pointer to the search environment
+* @param int **values - the solution the cell's value is taken from
+* @param int cell - the cell's index (row*N+col)
+* @param int assign - 1 to put the value in , 0 to take it out
+* @return void
+*/
+void setClue(bitEnv *env,int **values,int cell,int assign){
+    bitMask bit = (bitMask)1<<(values[cell/env->length][cell%env->length]-1);
+    if(assign)
+        bitAssign(env,cell,bit);
+    else
+        bitUnassign(env,cell,bit);
+}
+
+/**  allocPuzzle:
+* @brief Allocates a 2D array for a puzzle
+* @param int N - size of the puzzle's sides
+* @return int** - the array
+*/
+int **allocPuzzle(int N){
+    int i,**values;
+    values = (int**)malloc(N*sizeof(int*));
+    if(values==NULL){
+        printf("Error: memory allocation has failed in allocPuzzle, Exiting...\n");
+        exit(0);
+    }
+    for(i=0;i<N;i++){
+        values[i] = (int*)malloc(N*sizeof(int));
+        if(values[i]==NULL){
+            printf("Error: memory allocation has failed in allocPuzzle, Exiting...\n");
+            exit(0);
+        }
+    }
+    return values;
+}
+
+/**  freePuzzle:
+* @brief Frees a 2D array allocated by allocPuzzle
+* @param int **values - the array
+* @param int N - size of the puzzle's sides
+* @return void
+*/
+void freePuzzle(int **values,int N){
+    int i;
+    for(i=0;i<N;i++){
+        free(values[i]);
+    }
+    free(values);
+}
@@ -0,0 +1,9 @@
+#ifndef GENERATOR_H_INCLUDED
+#define GENERATOR_H_INCLUDED
+#include "bitSolver.h"
+
+/*Public functions declarations*/
+int generateBatch(char *fileName,int m,int n,int count,int clues,int difficulty,int symmetric,unsigned long seed);
+int genPuzzle(bitEnv *env,int **values,int *order,int clues,int difficulty,int symmetric);
+
+#endif
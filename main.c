@@ -2,7 +2,6 @@
 #include <stdlib.h>
 #include <time.h>
 #include "gameLogic.h"
-#include "LPSolver.h"
 
 
 int main() {
@@ -13,8 +12,8 @@ int main() {
         printf("Error: memory allocation has failed,Exiting...\n");
         exit(0);
     }
-    srand(time(NULL));
     initNewGame(sGame);
+    setSeed(sGame, (unsigned long) time(NULL));
 
     printf("Welcome to the Guy's sudoku!\n");
 
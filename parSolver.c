@@ -0,0 +1,266 @@
+#define _POSIX_C_SOURCE 200112L
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "parSolver.h"
+#include "bitSolver.h"
+
+/* Upper bound on the number of counting threads */
+#define PAR_MAX_THREADS 64
+/* Number of search subtrees prepared for every thread, so idle threads have work to steal */
+#define PAR_TASKS_PER_THREAD 16
+
+/* A structure to represent the search subtrees (tasks) left after splitting the search at a shallow depth */
+/* Member: int count - number of tasks */
+/* Member: int depth - length of every task's prefix of assignments */
+/* Member: int *cells - the prefix cells of task t, at cells[t*depth .. t*depth+depth-1] */
+/* Member: bitMask *bits - the values assigned to the prefix cells, laid out like cells */
+typedef struct par_tasks{
+    int count;
+    int depth;
+    int *cells;
+    bitMask *bits;
+}parTasks;
+
+/* A structure to represent a counting thread and its deque of tasks */
+/* Member: pthread_t thread - the thread running the worker (unused for the calling thread's worker) */
+/* Member: int id - index of the worker in the pool */
+/* Member: int head/tail - the worker's tasks are task indices head..tail-1; the owner takes from the tail and thieves from the head */
+/* Member: pthread_mutex_t lock - guards head and tail */
+/* Member: solCount count - solutions counted by this worker */
+/* Member: struct par_pool *pool - the pool the worker belongs to */
+typedef struct par_worker{
+    pthread_t thread;
+    int id;
+    int head;
+    int tail;
+    pthread_mutex_t lock;
+    solCount count;
+    struct par_pool *pool;
+}parWorker;
+
+/* A structure to represent the work-stealing pool */
+/* Member: sudokuBoard *sBoard - the board being counted (read only) */
+/* Member: parTasks *tasks - the tasks shared by all workers */
+/* Member: parWorker *workers - the pool's workers */
+/* Member: int workerCount - number of workers */
+typedef struct par_pool{
+    sudokuBoard *sBoard;
+    parTasks *tasks;
+    parWorker *workers;
+    int workerCount;
+}parPool;
+
+/*Private functions declarations*/
+void splitSearch(bitEnv *env,parTasks *tasks,int target);
+void applyTask(bitEnv *env,parTasks *tasks,int t);
+void undoTask(bitEnv *env,parTasks *tasks,int t);
+int takeTask(parWorker *worker);
+solCount addCounts(solCount a,solCount b);
+void *runWorker(void *arg);
+
+
+/**  parThreadCount:
+* @brief Finds how many threads the counting pool should use
+* @return int - number of online processors (at least 1 and at most PAR_MAX_THREADS)
+*/
+int parThreadCount(void){
+    long cpus;
+    cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if(cpus<1)
+        return 1;
+    if(cpus>PAR_MAX_THREADS)
+        return PAR_MAX_THREADS;
+    return (int)cpus;
+}
+
+/**  parCountSolutions:
+* @brief Counts the solutions of the board with a pool of work-stealing threads
+* @param sudokuBoard *sBoard - a pointer to the sudoku board being checked (board side must be at most BIT_MAX_LENGTH)
+* @param int threads - number of threads to count with (the calling thread included)
+* @return solCount - the number of different valid solutions to the board (SOL_COUNT_MAX means at least that many)
+*/
+solCount parCountSolutions(sudokuBoard *sBoard,int threads){
+    bitEnv env;
+    parTasks tasks;
+    parPool pool;
+    int i,started;
+    solCount count=0;
+    if(!bitEnvInit(&env,sBoard,mostConstrained)){
+        bitEnvFree(&env);
+        return 0;
+    }
+    splitSearch(&env,&tasks,threads*PAR_TASKS_PER_THREAD);
+    bitEnvFree(&env);
+    pool.sBoard = sBoard;
+    pool.tasks = &tasks;
+    pool.workerCount = threads;
+    pool.workers = (parWorker*)malloc(threads*sizeof(parWorker));
+    if(pool.workers==NULL){
+        printf("Error: memory allocation has failed in parCountSolutions, Exiting...\n");
+        exit(0);
+    }
+    for(i=0;i<threads;i++){/*Deal the tasks out in contiguous ranges*/
+        pool.workers[i].id = i;
+        pool.workers[i].head = (int)(((long)tasks.count*i)/threads);
+        pool.workers[i].tail = (int)(((long)tasks.count*(i+1))/threads);
+        pool.workers[i].count = 0;
+        pool.workers[i].pool = &pool;
+        pthread_mutex_init(&pool.workers[i].lock,NULL);
+    }
+    /*Worker 0 runs on the calling thread; if a thread can't be started its tasks get stolen (runWorker only returns once every deque is empty)*/
+    started = 1;
+    for(i=1;i<threads;i++){
+        if(pthread_create(&pool.workers[i].thread,NULL,runWorker,&pool.workers[i])!=0)
+            break;
+        started++;
+    }
+    runWorker(&pool.workers[0]);
+    for(i=1;i<started;i++){
+        pthread_join(pool.workers[i].thread,NULL);
+    }
+    for(i=0;i<threads;i++){
+        count = addCounts(count,pool.workers[i].count);
+        pthread_mutex_destroy(&pool.workers[i].lock);
+    }
+    free(pool.workers);
+    free(tasks.cells);
+    free(tasks.bits);
+    return count;
+}
+
+/**  splitSearch:
+* @brief Expands the search one level at a time until there are enough independent subtrees
+* @param bitEnv *env - a pointer to an initialized environment (restored on return)
+* @param parTasks *tasks - gets the subtrees, each as a prefix of assignments
+* @param int target - the number of tasks to aim for
+* @return void
+*/
+void splitSearch(bitEnv *env,parTasks *tasks,int target){
+    int t,k,cell,next,nextDepth,emptyCount;
+    int *cells;
+    bitMask *bits,candidates,bit;
+    emptyCount = env->emptyCount;
+    tasks->count = 1;
+    tasks->depth = 0;
+    tasks->cells = NULL;
+    tasks->bits = NULL;
+    while(tasks->count<target && tasks->depth<emptyCount){
+        nextDepth = tasks->depth+1;
+        cells = (int*)malloc(tasks->count*env->length*nextDepth*sizeof(int));
+        bits = (bitMask*)malloc(tasks->count*env->length*nextDepth*sizeof(bitMask));
+        if(cells==NULL || bits==NULL){
+            printf("Error: memory allocation has failed in splitSearch, Exiting...\n");
+            exit(0);
+        }
+        next = 0;
+        for(t=0;t<tasks->count;t++){
+            applyTask(env,tasks,t);
+            cell = bitChooseCell(env,&candidates);
+            while(candidates){/*A child subtree for every candidate of the chosen cell*/
+                bit = candidates & (~candidates+1);
+                candidates ^= bit;
+                for(k=0;k<tasks->depth;k++){
+                    cells[next*nextDepth+k] = tasks->cells[t*tasks->depth+k];
+                    bits[next*nextDepth+k] = tasks->bits[t*tasks->depth+k];
+                }
+                cells[next*nextDepth+tasks->depth] = cell;
+                bits[next*nextDepth+tasks->depth] = bit;
+                next++;
+            }
+            undoTask(env,tasks,t);
+        }
+        free(tasks->cells);
+        free(tasks->bits);
+        tasks->cells = cells;
+        tasks->bits = bits;
+        tasks->count = next;
+        tasks->depth = nextDepth;
+        if(next==0)/*Every branch is a dead end*/
+            break;
+    }
+}
+
+/**  applyTask:
+* @brief Assigns a task's prefix in an environment
+* @param bitEnv *env - a pointer to an initialized environment
+* @param parTasks *tasks - the tasks
+* @param int t - index of the task
+* @return void
+*/
+void applyTask(bitEnv *env,parTasks *tasks,int t){
+    int k;
+    for(k=0;k<tasks->depth;k++){
+        bitAssign(env,tasks->cells[t*tasks->depth+k],tasks->bits[t*tasks->depth+k]);
+    }
+}
+
+/**  undoTask:
+* @brief Withdraws a task's prefix from an environment, in reverse order of applyTask
+* @param bitEnv *env - a pointer to an initialized environment
+* @param parTasks *tasks - the tasks
+* @param int t - index of the task
+* @return void
+*/
+void undoTask(bitEnv *env,parTasks *tasks,int t){
+    int k;
+    for(k=tasks->depth-1;k>=0;k--){
+        bitUnassign(env,tasks->cells[t*tasks->depth+k],tasks->bits[t*tasks->depth+k]);
+    }
+}
+
+/**  takeTask:
+* @brief Takes the next task of a worker - from its own deque, or stolen from another worker
+* @param parWorker *worker - a pointer to the worker
+* @return int - index of the task , or -1 if no work is left
+*/
+int takeTask(parWorker *worker){
+    int i,t=-1;
+    parWorker *victim;
+    pthread_mutex_lock(&worker->lock);
+    if(worker->head<worker->tail){
+        t = --worker->tail;
+    }
+    pthread_mutex_unlock(&worker->lock);
+    for(i=1;t==-1 && i<worker->pool->workerCount;i++){
+        victim = &worker->pool->workers[(worker->id+i)%worker->pool->workerCount];
+        pthread_mutex_lock(&victim->lock);
+        if(victim->head<victim->tail){
+            t = victim->head++;
+        }
+        pthread_mutex_unlock(&victim->lock);
+    }
+    return t;
+}
+
+/**  runWorker:
+* @brief A counting thread: counts task subtrees on a private copy of the search state until no work is left
+* @param void *arg - a pointer to the thread's parWorker
+* @return void* - NULL
+*/
+void *runWorker(void *arg){
+    parWorker *worker = (parWorker*)arg;
+    parTasks *tasks = worker->pool->tasks;
+    bitEnv env;
+    int t;
+    bitEnvInit(&env,worker->pool->sBoard,mostConstrained);
+    while(worker->count<SOL_COUNT_MAX && (t=takeTask(worker))!=-1){
+        applyTask(&env,tasks,t);
+        worker->count = addCounts(worker->count,bitCountSolutions(&env,0));
+        undoTask(&env,tasks,t);
+    }
+    bitEnvFree(&env);
+    return NULL;
+}
+
+/**  addCounts:
+* @brief Adds two solution counts, saturating at SOL_COUNT_MAX instead of wrapping around
+* @param solCount a/b - the counts to add
+* @return solCount - the sum , or SOL_COUNT_MAX if it doesn't fit
+*/
+solCount addCounts(solCount a,solCount b){
+    if(SOL_COUNT_MAX-a<b)
+        return SOL_COUNT_MAX;
+    return a+b;
+}
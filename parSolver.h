@@ -0,0 +1,10 @@
+#ifndef PARSOLVER_H_INCLUDED
+#define PARSOLVER_H_INCLUDED
+#include "SudokuBoard.h"
+#include "solCount.h"
+
+/*Public functions declarations*/
+int parThreadCount(void);
+solCount parCountSolutions(sudokuBoard *sBoard,int threads);
+
+#endif
@@ -10,9 +10,13 @@ int isLegalFloat(char *str);
 int wordCount(char *str);
 /*Parsing functions*/
 int parseMarkErrors(Command *command, char *str);
+int parseSolverLog(Command *command, char *str);
+int parseSeed(Command *command, char *str);
 int parseSet(Command *command, char *str, int maxValue);
 int parseGuess(Command *command, char *str);
 int parseGenerate(Command *command, char *str, int maxValue);
+int parseGenerateUnique(Command *command, char *str, int maxValue);
+int parseGenerateBatch(Command *command, char *str);
 int parseGuessHint(Command *command, char *str, int maxValue);
 int parseHint(Command *command, char *str, int maxValue);
 /*Set-to-command-template functions*/
@@ -33,8 +37,12 @@ int parseCommandParams(Command *command, char *str, int maxValue) {
     if (command->commandType == solve || command->commandType == edit || command->commandType == save) {
         return (setFileTypeCommand(command, str));
     }
+    if (command->commandType == generate_batch) {
+        return parseGenerateBatch(command, str);
+    }
     if (command->commandType == mark_errors || command->commandType == set || command->commandType == guess ||
-        command->commandType == generate || command->commandType == hint || command->commandType == guess_hint) {
+        command->commandType == generate || command->commandType == generate_unique || command->commandType == hint || command->commandType == guess_hint ||
+        command->commandType == solver_log || command->commandType == randomSeed) {
         return (setIntTypeCommand(command, str, maxValue));
     }
     return setNoParamCommand(str);
@@ -84,6 +92,18 @@ int setCommandName(Command *command, char str[]) {
         command->commandType = generate;
         return 1;
     }
+    if (strcmp("generate_unique", token) == 0) {
+        command->commandType = generate_unique;
+        return 1;
+    }
+    if (strcmp("generate_batch", token) == 0) {
+        command->commandType = generate_batch;
+        return 1;
+    }
+    if (strcmp("seed", token) == 0) {
+        command->commandType = randomSeed;
+        return 1;
+    }
     if (strcmp("undo", token) == 0) {
         command->commandType = undo;
         return 1;
@@ -116,6 +136,10 @@ int setCommandName(Command *command, char str[]) {
         command->commandType = reset;
         return 1;
     }
+    if (strcmp("solver_log", token) == 0) {
+        command->commandType = solver_log;
+        return 1;
+    }
     if (strcmp("exit", token) == 0) {
         command->commandType = ex;
         return 1;
@@ -197,6 +221,40 @@ int parseMarkErrors(Command *command, char *str) {
 
 }
 
+int parseSolverLog(Command *command, char *str) {
+    int val;
+
+    if (wordCount(str) != 1) {
+        printf("Error: Wrong amount of parameters for solver_log: should be 1\n");
+        return 0;
+    }
+
+    if (sscanf(str, "%d", &val) == 1 && isLegalInt(str) && (val == 0 || val == 1)) {
+        command->x = val;
+        return 1;
+    }
+    printf("Error: Wrong parameter for solver_log - must be 0 or 1\n");
+    return 0;
+
+}
+
+int parseSeed(Command *command, char *str) {
+    int val;
+
+    if (wordCount(str) != 1) {
+        printf("Error: Wrong amount of parameters for seed: should be 1\n");
+        return 0;
+    }
+
+    if (sscanf(str, "%d", &val) == 1 && isLegalInt(str)) {
+        command->x = val;
+        return 1;
+    }
+    printf("Error: Wrong parameter for seed - must be a non-negative integer\n");
+    return 0;
+
+}
+
 int parseSet(Command *command, char *str, int maxValue) {
     int x, y, z;
     int stringsRead;
@@ -337,6 +395,72 @@ int parseGenerate(Command *command, char *str, int maxValue) {
 
 }
 
+int parseGenerateUnique(Command *command, char *str, int maxValue) {
+    int y, d, s;
+    int bytesRead = 0;
+    int offset = 0;
+
+    if (wordCount(str) != 3) {
+        printf("Error: Number of parameters is wrong - should be 3 for generate_unique\n");
+        return 0;
+    }
+
+    if (sscanf(str + offset, "%d%n", &y, &bytesRead) != 1 || !isLegalInt(str + offset) || y > maxValue) {
+        printf("Error: 1st param must be an integer between 0 and %d for generate_unique\n", maxValue);
+        return 0;
+    }
+    offset = offset + bytesRead;
+
+    if (sscanf(str + offset, "%d%n", &d, &bytesRead) != 1 || !isLegalInt(str + offset) || d > maxValue) {
+        printf("Error: 2nd param must be an integer between 0 and %d for generate_unique\n", maxValue);
+        return 0;
+    }
+    offset = offset + bytesRead;
+
+    if (sscanf(str + offset, "%d", &s) != 1 || !isLegalInt(str + offset) || (s != 0 && s != 1)) {
+        printf("Error: 3rd param must be 0 or 1 for generate_unique\n");
+        return 0;
+    }
+    command->x = y;
+    command->y = d;
+    command->z = s;
+    return 1;
+
+}
+
+/*params: file name, then block rows, block columns, count, clue target, difficulty target, symmetry (0/1), seed*/
+int parseGenerateBatch(Command *command, char *str) {
+    int i, val;
+    int bytesRead = 0;
+    int offset = 0;
+
+    if (wordCount(str) != BATCH_PARAMS + 1) {
+        printf("Error: Number of parameters is wrong - should be %d for generate_batch\n", BATCH_PARAMS + 1);
+        return 0;
+    }
+
+    sscanf(str, " %*s%n", &offset);
+    for (i = 0; i < BATCH_PARAMS; i++) {
+        if (sscanf(str + offset, "%d%n", &val, &bytesRead) != 1 || !isLegalInt(str + offset)) {
+            printf("Error: param %d must be a non-negative integer for generate_batch\n", i + 2);
+            return 0;
+        }
+        command->params[i] = val;
+        offset = offset + bytesRead;
+    }
+    if (command->params[0] == 0 || command->params[1] == 0 || command->params[2] == 0) {
+        printf("Error: block rows, block columns and count must be positive for generate_batch\n");
+        return 0;
+    }
+    if (command->params[5] > 1) {
+        printf("Error: 7th param must be 0 or 1 for generate_batch\n");
+        return 0;
+    }
+    command->fileName = strtok(str, " \n\r\t");
+    return 1;
+
+}
+
 int parseGuessHint(Command *command, char *str, int maxValue) {
     int x, y;
     int stringsRead;
@@ -472,12 +596,21 @@ int setIntTypeCommand(Command *command, char *str, int boardLen) {
     if (command->commandType == generate) {
         return parseGenerate(command, str, boardLen * boardLen);
     }
+    if (command->commandType == generate_unique) {
+        return parseGenerateUnique(command, str, boardLen * boardLen);
+    }
     if (command->commandType == hint) {
         return parseHint(command, str, boardLen);
     }
     if (command->commandType == guess_hint) {
         return parseGuessHint(command, str, boardLen);
     }
+    if (command->commandType == solver_log) {
+        return parseSolverLog(command, str);
+    }
+    if (command->commandType == randomSeed) {
+        return parseSeed(command, str);
+    }
 
 
     return 0;
@@ -0,0 +1,95 @@
+#include "rng.h"
+
+/* Mask of the 32 bits the generator works in (an unsigned long may be wider) */
+#define RNG_MASK 0xFFFFFFFFUL
+
+/* Rotates a 32-bit word left by k bits */
+#define RNG_ROTL(x,k) ((((x)<<(k)) | ((x)>>(32-(k)))) & RNG_MASK)
+
+/*Private functions declarations*/
+unsigned long rngMix(unsigned long z);
+
+
+/**  rngSeed:
+* @brief Sets a generator's state from a seed - the state words are drawn from a splitmix sequence started at the seed ,
+*        so close seeds give unrelated sequences
+* @param rngState *rng - a pointer to the generator
+* @param unsigned long seed - any number (equal seeds give equal sequences)
+* @return void
+*/
+void rngSeed(rngState *rng,unsigned long seed){
+    unsigned long x = seed & RNG_MASK;
+    int k;
+    for(k=0;k<4;k++){
+        x = (x+0x9E3779B9UL) & RNG_MASK;
+        rng->s[k] = rngMix(x);
+    }
+    if((rng->s[0]|rng->s[1]|rng->s[2]|rng->s[3])==0)/*The one state the generator can't leave*/
+        rng->s[0] = 1;
+}
+
+/**  rngSeedStream:
+* @brief Sets a generator's state for one of the numbered streams of a seed (like the puzzles of a batch). Seeding with
+*        seed+stream*step would shift the splitmix sequence rngSeed draws from , so neighbouring streams would share
+*        state words - the stream number is scrambled into the seed instead
+* @param rngState *rng - a pointer to the generator
+* @param unsigned long seed - any number
+* @param unsigned long stream - the stream's number (equal seeds and streams give equal sequences)
+* @return void
+*/
+void rngSeedStream(rngState *rng,unsigned long seed,unsigned long stream){
+    rngSeed(rng,rngMix((seed^rngMix((stream+0x9E3779B9UL) & RNG_MASK)) & RNG_MASK));
+}
+
+/**  rngNext:
+* @brief Advances a generator one step
+* @param rngState *rng - a pointer to the generator
+* @return unsigned long - 32 random bits
+*/
+unsigned long rngNext(rngState *rng){
+    unsigned long *s = rng->s,result,t;
+    result = (RNG_ROTL((s[1]*5) & RNG_MASK,7)*9) & RNG_MASK;
+    t = (s[1]<<9) & RNG_MASK;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = RNG_ROTL(s[3],11);
+    return result;
+}
+
+/**  rngBelow:
+* @brief Draws a number in [0,n) with every number equally likely - draws from the uneven tail of the 32-bit range are redone
+* @param rngState *rng - a pointer to the generator
+* @param int n - the bound (positive)
+* @return int - the drawn number
+*/
+int rngBelow(rngState *rng,int n){
+    unsigned long bound = (unsigned long)n,limit,r;
+    limit = RNG_MASK - (RNG_MASK%bound + 1)%bound;/*The largest draw that keeps every residue equally likely*/
+    do{
+        r = rngNext(rng);
+    }while(r>limit);
+    return (int)(r%bound);
+}
+
+/**  rngFraction:
+* @brief Draws a number in [0,1)
+* @param rngState *rng - a pointer to the generator
+* @return double - the drawn number
+*/
+double rngFraction(rngState *rng){
+    return rngNext(rng)/4294967296.0;
+}
+
+/**  rngMix:
+* @brief The splitmix finalizer - scrambles a 32-bit word so that close inputs give unrelated outputs
+* @param unsigned long z - the word
+* @return unsigned long - the scrambled word
+*/
+unsigned long rngMix(unsigned long z){
+    z = ((z^(z>>16))*0x85EBCA6BUL) & RNG_MASK;
+    z = ((z^(z>>13))*0xC2B2AE35UL) & RNG_MASK;
+    return z^(z>>16);
+}
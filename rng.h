@@ -0,0 +1,17 @@
+#ifndef RNG_H_INCLUDED
+#define RNG_H_INCLUDED
+
+/* A structure to represent the state of a xoshiro128** pseudo-random generator - every game and thread keeps its own */
+/* Member: unsigned long s[4] - the generator's four 32-bit state words (never all 0) */
+typedef struct rng_state{
+    unsigned long s[4];
+}rngState;
+
+/*Public functions declarations*/
+void rngSeed(rngState *rng,unsigned long seed);
+void rngSeedStream(rngState *rng,unsigned long seed,unsigned long stream);
+unsigned long rngNext(rngState *rng);
+int rngBelow(rngState *rng,int n);
+double rngFraction(rngState *rng);
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef SOLCOUNT_H_INCLUDED
+#define SOLCOUNT_H_INCLUDED
+#include <limits.h>
+
+/* A count of board solutions (64 bits wide on LP64 platforms) */
+typedef unsigned long solCount;
+
+/* Counts saturate at SOL_COUNT_MAX: a search that reaches it stops, and the count is only a lower bound */
+#define SOL_COUNT_MAX ULONG_MAX
+
+#endif
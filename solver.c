@@ -0,0 +1,324 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "solver.h"
+#include "bitSolver.h"
+#include "dlxSolver.h"
+#ifdef USE_GUROBI
+#include "LPSolver.h"
+#endif
+
+/*Private functions declarations*/
+int nativeSolve(sudokuGame *sGame);
+int nativeSearch(sudokuGame *sGame,int randomOrder);
+int nativeGuess(sudokuGame *sGame,double x);
+int nativeGuessHint(sudokuGame *sGame,int row,int col);
+int sampleScores(sudokuGame *sGame,double *scores);
+int isSolutionOf(sudokuGame *sGame);
+int pickWeighted(double *cumulative,int count,double draw);
+
+/* The linked backends , in order of preference */
+const solverBackend solverBackends[] = {
+#ifdef USE_GUROBI
+    {"gurobi", ILPSolver, LPSolverGuess, LPSolverGuessHint, LPSolverRelease},
+#endif
+    {"native", nativeSolve, NULL, NULL, NULL}
+    ,{"sampling", NULL, nativeGuess, nativeGuessHint, NULL}
+};
+
+
+/**  findSolver:
+* @brief Finds the preferred backend that can do a job
+* @param SOLVER_TASK task - the job
+* @return const solverBackend* - the backend , or NULL if no linked backend can do the job
+*/
+const solverBackend *findSolver(SOLVER_TASK task){
+    int i,count = sizeof(solverBackends)/sizeof(solverBackends[0]);
+    for(i=0;i<count;i++){
+        if(task==exactSolve && solverBackends[i].solve!=NULL)
+            return &solverBackends[i];
+        if(task==lpGuess && solverBackends[i].guess!=NULL)
+            return &solverBackends[i];
+    }
+    return NULL;
+}
+
+/**  solveBoard:
+* @brief Solves the game's board with the preferred exact backend. The result is kept for the board's version , and
+*        a solution is reused as long as the board only holds values that agree with it
+* @param sudokuGame *sGame - a pointer to the sudoku game being played
+* @return int - 1 if the board was solved and currSol member of the game was updated, 0 o/w
+*/
+int solveBoard(sudokuGame *sGame){
+    unsigned long version = boardVersion(sGame->currBoard);
+    if(sGame->solVersion==version)
+        return 1;
+    if(sGame->noSolVersion==version)
+        return 0;
+    if(sGame->solVersion==0 || !isSolutionOf(sGame)){
+        sGame->solVersion = 0;
+        if(!findSolver(exactSolve)->solve(sGame)){
+            sGame->noSolVersion = version;
+            return 0;
+        }
+    }
+    sGame->solVersion = version;
+    return 1;
+}
+
+/**  randomSolveBoard:
+* @brief Fills the game's currSol with a random solution of its board , found in a single pass of the propagating
+*        search with candidates tried in random order (boards too wide for a bitMask get Dancing Links' first solution)
+* @param sudokuGame *sGame - a pointer to the sudoku game being played
+* @return int - 1 if the board was solved and currSol member of the game was updated, 0 o/w
+*/
+int randomSolveBoard(sudokuGame *sGame){
+    unsigned long version = boardVersion(sGame->currBoard);
+    if(sGame->noSolVersion==version)
+        return 0;
+    sGame->solVersion = 0;
+    if(!nativeSearch(sGame,1)){
+        sGame->noSolVersion = version;
+        return 0;
+    }
+    sGame->solVersion = version;
+    return 1;
+}
+
+/**  isSolutionOf:
+* @brief Checks if the game's current solution still solves its board - every set cell holds the solution's value
+* @param sudokuGame *sGame - a pointer to the sudoku game being played
+* @return int - 1 if it does , 0 o/w
+*/
+int isSolutionOf(sudokuGame *sGame){
+    int i,j,value,N=sGame->currBoard->length;
+    for(i=0;i<N;i++){
+        for(j=0;j<N;j++){
+            value = CELL(sGame->currBoard,i,j).value;
+            if(value!=0 && value!=sGame->currSol[i][j])
+                return 0;
+        }
+    }
+    return 1;
+}
+
+/**  releaseSolvers:
+* @brief Lets every backend free what it keeps in the game between calls
+* @param sudokuGame *sGame - a pointer to the sudoku game being played
+* @return void
+*/
+void releaseSolvers(sudokuGame *sGame){
+    int i,count = sizeof(solverBackends)/sizeof(solverBackends[0]);
+    for(i=0;i<count;i++){
+        if(solverBackends[i].release!=NULL)
+            solverBackends[i].release(sGame);
+    }
+}
+
+/**  nativeSolve:
+* @brief The native exact backend - propagation and bitmask search , or Dancing Links for boards too wide for a bitMask
+* @param sudokuGame *sGame - a pointer to the sudoku game being played
+* @return int - 1 if the board was solved and currSol member of the game was updated, 0 o/w
+*/
+int nativeSolve(sudokuGame *sGame){
+    return nativeSearch(sGame,0);
+}
+
+/**  nativeSearch:
+* @brief Solves the game's board into currSol with propagation and bitmask search , or Dancing Links for boards too wide for a bitMask
+* @param sudokuGame *sGame - a pointer to the sudoku game being played
+* @param int randomOrder - 1 to try every cell's candidates in random order (see bitSample/dlxSample) , 0 to try them in order
+* @return int - 1 if the board was solved and currSol member of the game was updated, 0 o/w
+*/
+int nativeSearch(sudokuGame *sGame,int randomOrder){
+    sudokuBoard *sBoard = sGame->currBoard;
+    bitEnv env;
+    int i,j,solved;
+    if(sBoard->length>BIT_MAX_LENGTH)
+        return randomOrder ? dlxSample(sBoard,sGame->currSol,&sGame->rng) : dlxSolve(sBoard,sGame->currSol,1)>0;
+    for(i=0;i<sBoard->length;i++){
+        for(j=0;j<sBoard->length;j++){
+            sGame->currSol[i][j] = CELL(sBoard,i,j).value;
+        }
+    }
+    solved = bitEnvInit(&env,sBoard,mostConstrained);
+    env.rng = &sGame->rng;
+    if(solved)
+        solved = randomOrder ? bitSample(&env,sGame->currSol) : bitSolve(&env,sGame->currSol);
+    bitEnvFree(&env);
+    return solved;
+}
+
+/**  nativeGuess:
+* @brief The native guess engine - fills the board by scores sampled from random solutions
+* @param sudokuGame *sGame - a pointer to the sudoku game being played
+* @param double x - a threshold number for setting guesses to the board
+* @return int - 1 if the scores were found , 0 if the board has no solution
+*/
+int nativeGuess(sudokuGame *sGame,double x){
+    double *scores = allocateGuessScores(sGame->currBoard->length);
+    int found = sampleScores(sGame,scores);
+    if(found)
+        applyGuessScores(sGame,scores,x,&sGame->rng);
+    free(scores);
+    return found;
+}
+
+/**  nativeGuessHint:
+* @brief The native guess engine - prints the scores of a cell , sampled from random solutions
+* @param sudokuGame *sGame - a pointer to the sudoku game being played
+* @param int row/col - indicates for which cell a guess hint should be made (0-based)
+* @return int - 1 if the scores were found , 0 if the board has no solution
+*/
+int nativeGuessHint(sudokuGame *sGame,int row,int col){
+    double *scores = allocateGuessScores(sGame->currBoard->length);
+    int found = sampleScores(sGame,scores);
+    if(found)
+        printGuessScores(sGame,scores,row,col);
+    free(scores);
+    return found;
+}
+
+/**  sampleScores:
+* @brief Scores every (empty cell,value) pair by the share of GUESS_SAMPLES random solutions that place the value there.
+*        The first sample decides if the board is solvable and may take as long as it needs , the rest get a budget
+*        (see GUESS_SAMPLE_BUDGET) and the scores come from the samples found until one runs out of it.
+*        Boards too wide for a bitMask are scored by a single random Dancing Links solution
+* @param sudokuGame *sGame - a pointer to the sudoku game being played
+* @param double *scores - gets the scores (see allocateGuessScores)
+* @return int - 1 if the board has a solution , 0 o/w
+*/
+int sampleScores(sudokuGame *sGame,double *scores){
+    sudokuBoard *sBoard = sGame->currBoard;
+    bitEnv env;
+    int **sample;
+    int i,j,s,found=0,N=sBoard->length;
+    sample = (int **) malloc(N*sizeof(int *));
+    if(sample==NULL){
+        printf("Error: memory allocation has failed in sampleScores, Exiting...\n");
+        exit(0);
+    }
+    for(i=0;i<N;i++){
+        sample[i] = (int *) calloc(N,sizeof(int));
+        if(sample[i]==NULL){
+            printf("Error: memory allocation has failed in sampleScores, Exiting...\n");
+            exit(0);
+        }
+    }
+    if(N>BIT_MAX_LENGTH){
+        found = dlxSample(sBoard,sample,&sGame->rng);
+    }
+    else{
+        if(bitEnvInit(&env,sBoard,mostConstrained)){
+            env.rng = &sGame->rng;
+            for(s=0;s<GUESS_SAMPLES && bitSample(&env,sample)==1;s++){
+                found++;
+                for(i=0;i<N;i++){
+                    for(j=0;j<N;j++){
+                        if(CELL(sBoard,i,j).value==0)
+                            scores[(i*N+j)*N+sample[i][j]-1] += 1.0;
+                    }
+                }
+                env.budget = GUESS_SAMPLE_BUDGET*(unsigned long)N*N;
+            }
+        }
+        bitEnvFree(&env);
+    }
+    for(i=0;i<N;i++){
+        for(j=0;j<N && found;j++){
+            if(CELL(sBoard,i,j).value!=0)
+                continue;
+            if(N>BIT_MAX_LENGTH)
+                scores[(i*N+j)*N+sample[i][j]-1] = 1.0;
+            else
+                for(s=0;s<N;s++)
+                    scores[(i*N+j)*N+s] /= found;
+        }
+        free(sample[i]);
+    }
+    free(sample);
+    return found>0;
+}
+
+/**  allocateGuessScores:
+* @brief Allocates a guess score array - a score in [0,1] for every (cell,value) pair at (row*N+col)*N+value-1 , all 0
+* @param int N - the side of the board
+* @return double* - the scores , free with free
+*/
+double *allocateGuessScores(int N){
+    double *scores = (double *) calloc(N*N*N,sizeof(double));
+    if(scores==NULL){
+        printf("Error: memory allocation has failed in allocateGuessScores, Exiting...\n");
+        exit(0);
+    }
+    return scores;
+}
+
+/**  applyGuessScores:
+* @brief Fills every empty cell with one of its legal values scored above x , picked at random by score (as a single move)
+* @param sudokuGame *sGame - a pointer to the sudoku game being played
+* @param double *scores - the guess scores (see allocateGuessScores)
+* @param double x - a threshold number for setting guesses to the board
+* @param rngState *rng - the generator the picks are drawn from
+* @return void
+*/
+void applyGuessScores(sudokuGame *sGame,double *scores,double x,rngState *rng){
+    int i,j,v,DIM=sGame->currBoard->length;
+    double *cumulative,*cellScores,total;
+    cumulative = (double *) malloc(DIM*sizeof(double));/*Scratch buffer shared by all cells*/
+    if(cumulative==NULL){
+        printf("Error: memory allocation has failed in applyGuessScores, Exiting...\n");
+        exit(0);
+    }
+    /*PUSH MOVE FOR MULTI-CELL MOVE*/
+    pushGameMove(sGame);
+    for(i=0;i<DIM;i++){
+        for(j=0;j<DIM;j++){
+            cellScores = scores+(i*DIM+j)*DIM;
+            total = 0;
+            for(v=0;v<DIM;v++){/*Running sums of the scores of the candidate values*/
+                if(cellScores[v]>x && isLegalValue(sGame->currBoard,i,j,v))
+                    total += cellScores[v];
+                cumulative[v] = total;
+            }
+            if(total>0)
+                gameSetCell(sGame,i,j,pickWeighted(cumulative,DIM,total*rngFraction(rng))+1,1);
+        }
+    }
+    free(cumulative);
+}
+
+/**  pickWeighted:
+* @brief Finds the index a draw falls on , when weights are laid end to end
+* @param double *cumulative - running sums of the weights (cumulative[k] is the sum of weights 0..k)
+* @param int count - number of weights
+* @param double draw - a number in [0,cumulative[count-1])
+* @return int - the first index whose running sum is greater than draw
+*/
+int pickWeighted(double *cumulative,int count,double draw){
+    int low=0,high=count-1,mid;
+    while(low<high){
+        mid = (low+high)/2;
+        if(cumulative[mid]>draw)
+            high = mid;
+        else
+            low = mid+1;
+    }
+    return low;
+}
+
+/**  printGuessScores:
+* @brief Prints the legal values of a cell that have a positive guess score , with their scores
+* @param sudokuGame *sGame - a pointer to the sudoku game being played
+* @param double *scores - the guess scores (see allocateGuessScores)
+* @param int row/col - the cell (0-based)
+* @return void
+*/
+void printGuessScores(sudokuGame *sGame,double *scores,int row,int col){
+    int v,DIM=sGame->currBoard->length;
+	printf("Valid values options for cell <%d,%d> are\n",col+1,row+1);
+	for(v=0;v<DIM;v++){
+        if(scores[(row*DIM+col)*DIM+v]>0 && isLegalValue(sGame->currBoard,row,col,v)){
+            printf("Chances for value %d is %.2f\n",v+1,scores[(row*DIM+col)*DIM+v]);
+        }
+	}
+}
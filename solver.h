@@ -0,0 +1,38 @@
+#ifndef SOLVER_H_INCLUDED
+#define SOLVER_H_INCLUDED
+#include "SudokuGame.h"
+
+/* Number of random solutions the native guess engine scores from */
+#define GUESS_SAMPLES 20
+/* Values each sample after the first may place , per cell of the board , before the engine settles for the samples it has */
+#define GUESS_SAMPLE_BUDGET 256
+
+/* The jobs a solver backend can do */
+typedef enum solverTask{
+    exactSolve, lpGuess
+}SOLVER_TASK;
+
+/* A structure to represent a solver backend - any job a backend can't do is NULL */
+/* Member: const char* name - the backend's name */
+/* Member: solve - fills the game's currSol with a solution of its board , returns 1 if solved and 0 o\w */
+/* Member: guess - fills the board by guess scores with threshold x (see applyGuessScores) , returns 1 on success and 0 o\w */
+/* Member: guessHint - prints the guess scores of a cell (see printGuessScores) , returns 1 on success and 0 o\w */
+/* Member: release - frees whatever the backend keeps in the game between calls */
+typedef struct solver_backend{
+    const char *name;
+    int (*solve)(sudokuGame *sGame);
+    int (*guess)(sudokuGame *sGame,double x);
+    int (*guessHint)(sudokuGame *sGame,int row,int col);
+    void (*release)(sudokuGame *sGame);
+}solverBackend;
+
+/*Public functions declarations*/
+const solverBackend *findSolver(SOLVER_TASK task);
+int solveBoard(sudokuGame *sGame);
+int randomSolveBoard(sudokuGame *sGame);
+void releaseSolvers(sudokuGame *sGame);
+double *allocateGuessScores(int N);
+void applyGuessScores(sudokuGame *sGame,double *scores,double x,rngState *rng);
+void printGuessScores(sudokuGame *sGame,double *scores,int row,int col);
+
+#endif
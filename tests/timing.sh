@@ -0,0 +1,57 @@
+#!/bin/sh
+# Times generate , generate_unique and validate on 16x16 , 25x25 and 36x36 boards , checking from a fresh game so no cached solution is reused.
+# Usage: sh tests/timing.sh [console binary] - fails if a board isn't generated , or found solvable , within LIMIT seconds (default 30)
+BIN=${1:-./sudoku-console}
+LIMIT=${LIMIT:-30}
+DIR=$(mktemp -d) || exit 1
+trap 'rm -rf "$DIR"' EXIT
+failed=0
+
+# emptyBoard m n file - writes an empty board with m x n blocks
+emptyBoard(){
+    N=$(($1*$2))
+    echo "$1 $2" > "$3"
+    i=0
+    while [ $i -lt $N ]; do
+        j=0; row=""
+        while [ $j -lt $N ]; do row="$row 0"; j=$((j+1)); done
+        echo "$row" >> "$3"
+        i=$((i+1))
+    done
+}
+
+emptyBoard 4 4 "$DIR/e16.txt"
+emptyBoard 5 5 "$DIR/e25.txt"
+emptyBoard 6 6 "$DIR/e36.txt"
+# shape seed clues
+for spec in "e16 1 60" "e16 2 60" "e16 3 100" "e25 1 150" "e25 1 300" "e25 2 200" "e25 3 150" "e25 6 300" "e25 4 10" "e36 4 10"; do
+    set -- $spec
+    board="$DIR/$1_$2_$3.txt"
+    printf 'seed %s\nedit %s\ngenerate 0 %s\nsave %s\nexit\n' "$2" "$DIR/$1.txt" "$3" "$board" | timeout "$LIMIT" "$BIN" > /dev/null
+    if [ ! -s "$board" ]; then
+        echo "FAIL $1 seed $2 , $3 clues - not generated within ${LIMIT}s"
+        failed=1
+        continue
+    fi
+    start=$(date +%s)
+    if printf 'seed 1\nsolve %s\nvalidate\nexit\n' "$board" | timeout "$LIMIT" "$BIN" | grep -q "Board is solvable"; then
+        echo "ok   $1 seed $2 , $3 clues ($(($(date +%s)-start))s)"
+    else
+        echo "FAIL $1 seed $2 , $3 clues - not validated within ${LIMIT}s"
+        failed=1
+    fi
+done
+# seed clues - generate_unique on an empty 16x16 board , then the puzzle must have a single solution
+for spec in "1 100" "2 100" "1 90" "2 90"; do
+    set -- $spec
+    board="$DIR/u16_$1_$2.txt"
+    start=$(date +%s)
+    printf 'seed %s\nedit %s\ngenerate_unique %s 0 0\nsave %s\nexit\n' "$1" "$DIR/e16.txt" "$2" "$board" | timeout "$LIMIT" "$BIN" > /dev/null
+    if [ -s "$board" ] && printf 'solve %s\nnum_solutions\nexit\n' "$board" | timeout "$LIMIT" "$BIN" | grep -q "has 1 different solutions"; then
+        echo "ok   e16 seed $1 , unique with $2 clues ($(($(date +%s)-start))s)"
+    else
+        echo "FAIL e16 seed $1 , unique with $2 clues - not generated within ${LIMIT}s"
+        failed=1
+    fi
+done
+exit $failed